@@ -5,7 +5,8 @@
  * A 128 x 128 pixel display is treated as a grid of 16 x 16 tiles of 8 x 8 pixels.
  * The library is designed to write to a 90-degree rotated display (with the top connecting pins on the right), be very lightweight in memory and data transfer, and avoid interrupts.
  *
- * It utilises the u8g2lib library by Oliver Kraus 2016, which must be included and set up in the main sketch.
+ * It utilises the u8g2lib library by Oliver Kraus 2016, which must be included and set up in the main sketch
+ * before this header, and each display object is passed to the library, e.g. U8x8TilesR3 display(u8x8);
  *
  * The library provides limited functions to draw numbers, letters, symbols, dials, and indicator bars.
  * 
@@ -19,401 +20,1461 @@
 #ifndef U8X8TILESR3_H_
 #define U8X8TILESR3_H_
 
-class U8x8TilesR3 {
+#include <stdint.h>
+#include <string.h>
+
+// Glyph tables are shared by every instance and live in flash on AVR (PROGMEM),
+// elsewhere they are plain constexpr read-only data.
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#define U8X8TILESR3_PROGMEM PROGMEM
+#define U8X8TILESR3_READ_TILE(dst, src) memcpy_P((dst), (src), 8)
+#define U8X8TILESR3_READ_BYTE(src) pgm_read_byte(src)
+#define U8X8TILESR3_READ_WORD(src) pgm_read_word(src)
+#else
+#define U8X8TILESR3_PROGMEM
+#define U8X8TILESR3_READ_TILE(dst, src) memcpy((dst), (src), 8)
+#define U8X8TILESR3_READ_BYTE(src) (*(const uint8_t *)(src))
+#define U8X8TILESR3_READ_WORD(src) (*(const uint16_t *)(src))
+#endif
+
+// Optional shadow of the 16 x 16 tile grid so that tiles already on the panel are not re-sent.
+// Define U8X8TILESR3_SHADOW before including this header to select a mode:
+// NONE keeps no state, HASH keeps a 16-bit hash per tile (512 bytes) and may very rarely
+// skip a changed tile whose hash collides, FULL keeps a copy of every tile (2 KB).
+#define U8X8TILESR3_SHADOW_NONE 0
+#define U8X8TILESR3_SHADOW_HASH 1
+#define U8X8TILESR3_SHADOW_FULL 2
+#ifndef U8X8TILESR3_SHADOW
+#define U8X8TILESR3_SHADOW U8X8TILESR3_SHADOW_NONE
+#endif
+
+// Optional queue of tile writes between beginBatch() and flush(), costing 10 bytes of RAM per entry.
+// Queued tiles that sit side by side on a display page are sent in a single drawTile call.
+// Define U8X8TILESR3_BATCH_SIZE before including this header to enable it, from 2 to 255 e.g. 16.
+#ifndef U8X8TILESR3_BATCH_SIZE
+#define U8X8TILESR3_BATCH_SIZE 0
+#endif
+
+// Optional counters of the calls, tiles, bytes and transfer time of each group of draw functions,
+// read with stats() or printed with printStats(Serial). Define U8X8TILESR3_STATS 1 before
+// including this header to enable them, costing about 350 bytes of RAM per panel, plus 1 per batch entry;
+// off, they compile to nothing.
+#ifndef U8X8TILESR3_STATS
+#define U8X8TILESR3_STATS 0
+#endif
+#if U8X8TILESR3_STATS
+#define U8X8TILESR3_API(api) ApiScope apiScope(this, U8x8TilesR3Stats::api)
+#if defined(ARDUINO)
+#define U8X8TILESR3_TEXT(s) F(s)
+#define U8X8TILESR3_FLASH_TEXT(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#else
+#define U8X8TILESR3_TEXT(s) (s)
+#define U8X8TILESR3_FLASH_TEXT(p) (p)
+#endif
+#else
+#define U8X8TILESR3_API(api)
+#endif
+
+namespace U8x8TilesR3Glyphs {
+  // 0,0 is top left corner
+  // circle4 filling in four frames, open to filled, kept together as the tile pool of the circle4Fill animation
+  constexpr uint8_t circle4Frames[4][4][8] U8X8TILESR3_PROGMEM = {
+    {{ 0, 7, 24, 32, 32, 64, 64, 64 }, {  0, 224, 24, 4, 4, 2, 2, 2 }, { 64, 64, 64, 32, 32, 24, 7, 0 }, {2, 2, 2, 4, 4, 24, 224, 0 }},
+    {{ 0, 7, 24, 34, 36, 72, 72, 72 }, { 0, 224, 24, 196, 36, 18, 18, 18 }, { 72, 72, 72, 36, 35, 24, 7, 0 }, {18, 18, 18, 36, 196, 24, 224, 0 }},
+    {{ 0, 7, 24, 35, 36, 73, 74, 74 }, { 0, 224, 24, 196, 36, 146, 82, 82 }, { 74, 74, 73, 36, 35, 24, 7, 0 }, {82, 82, 146, 36, 196, 24, 224, 0 }},
+    {{ 0, 7, 31, 63, 63, 127, 127, 127 }, { 0, 224, 248, 252, 252, 254, 254, 254 }, { 127, 127, 127, 63, 63, 31, 7, 0 }, {254, 254, 254, 252, 252, 248, 224, 0 }}};
+  constexpr const uint8_t (&circle4)[4][8] = circle4Frames[0];
+  constexpr const uint8_t (&circle4_1)[4][8] = circle4Frames[1];
+  constexpr const uint8_t (&circle4_2)[4][8] = circle4Frames[2];
+  constexpr const uint8_t (&circle4_3)[4][8] = circle4Frames[3];
+  // circle4Fill: pool tiles of frame 0, then each frame's changes as position, tile pairs (every tile changes here)
+  constexpr uint8_t circle4FillKey[4] U8X8TILESR3_PROGMEM = { 0, 1, 2, 3 };
+  constexpr uint8_t circle4FillDeltas[36] U8X8TILESR3_PROGMEM = { 4, 0, 0, 1, 1, 2, 2, 3, 3,  4, 0, 4, 1, 5, 2, 6, 3, 7,
+    4, 0, 8, 1, 9, 2, 10, 3, 11,  4, 0, 12, 1, 13, 2, 14, 3, 15 };
+  // circle9 tiles 0 - 8 followed by the dial needle tiles, indexed by dial9States
+  constexpr uint8_t dial9Tiles[43][8] U8X8TILESR3_PROGMEM = {
+    { 0, 0, 7, 4, 8, 16, 32, 32 }, { 0, 126, 129, 0, 0, 0, 0, 0 }, { 0, 0, 224, 32, 16, 8, 4, 4 }, { 32, 64, 64, 64, 64, 64, 64, 32 }, { 0, 0, 0, 24, 24, 16, 16, 16 }, { 4, 2, 2, 2, 2, 2, 2, 4 }, { 32, 32, 16, 8, 4, 3, 0, 0 }, { 16, 16, 16, 16, 16, 129, 126, 0 }, { 4, 4, 8, 16, 32, 192, 0, 0 }, // circle9 0 - 8
+    { 0, 0, 0, 24, 24, 16, 48, 48 }, { 112, 112, 112, 240, 240, 240, 126, 0 }, // dial9_1 9 - 10
+    { 32, 64, 64, 64, 64, 64, 64, 35 }, { 0, 0, 0, 24, 24, 48, 112, 240 }, { 63, 63, 31, 15, 7, 3, 0, 0 }, { 240, 240, 240, 240, 240, 241, 126, 0 }, // dial9_2 11 - 14
+    { 32, 64, 64, 64, 127, 127, 127, 63 }, { 0, 0, 0, 24, 248, 240, 240, 240 }, // dial9_3 15 - 16
+    { 56, 127, 127, 127, 127, 127, 127, 63 }, { 0, 0, 192, 248, 248, 240, 240, 240 }, // dial9_4 17 - 18
+    { 0, 0, 3, 7, 15, 31, 63, 63 }, { 0, 126, 129, 0, 0, 128, 128, 128 }, { 63, 127, 127, 127, 127, 127, 127, 63 }, { 192, 192, 224, 248, 248, 240, 240, 240 }, // dial9_5 19 - 22
+    { 0, 126, 241, 240, 240, 240, 240, 240 }, { 240, 240, 240, 248, 248, 240, 240, 240 }, // dial9_6 23 - 24
+    { 0, 126, 255, 255, 255, 255, 255, 255 }, { 0, 0, 224, 160, 144, 8, 4, 4 }, { 254, 252, 252, 248, 248, 240, 240, 240 }, // dial9_7 25 - 27
+    { 0, 0, 192, 224, 240, 248, 252, 252 }, { 255, 255, 255, 252, 248, 240, 240, 240 }, { 244, 194, 2, 2, 2, 2, 2, 4 }, // dial9_8 28 - 30
+    { 255, 255, 255, 255, 248, 240, 240, 240 }, { 252, 254, 254, 254, 2, 2, 2, 4 }, // dial9_9 31 - 32
+    { 255, 255, 255, 255, 255, 243, 240, 240 }, { 252, 254, 254, 254, 254, 254, 254, 60 }, { 12, 4, 8, 16, 32, 192, 0, 0 }, // dial9_10 33 - 35
+    { 255, 255, 255, 255, 255, 247, 243, 241 }, { 252, 254, 254, 254, 254, 254, 254, 252 }, { 241, 240, 240, 240, 240, 241, 126, 0 }, { 252, 252, 248, 112, 96, 192, 0, 0 }, // dial9_11 36 - 39
+    { 255, 255, 255, 255, 255, 255, 255, 255 }, { 255, 255, 255, 255, 255, 255, 126, 0 }, { 252, 252, 248, 240, 224, 192, 0, 0 } // dial9_12 40 - 42
+  };
+  constexpr const uint8_t (*circle9)[8] = dial9Tiles;
+  // tile pool index for each of the 9 tiles (row by row) of the 13 dial9 states
+  constexpr uint8_t dial9States[13][9] U8X8TILESR3_PROGMEM = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8 }, // 0
+    {  0,  1,  2,  3,  9,  5,  6, 10,  8 }, // 1
+    {  0,  1,  2, 11, 12,  5, 13, 14,  8 }, // 2
+    {  0,  1,  2, 15, 16,  5, 13, 14,  8 }, // 3
+    {  0,  1,  2, 17, 18,  5, 13, 14,  8 }, // 4
+    { 19, 20,  2, 21, 22,  5, 13, 14,  8 }, // 5
+    { 19, 23,  2, 21, 24,  5, 13, 14,  8 }, // 6
+    { 19, 25, 26, 21, 27,  5, 13, 14,  8 }, // 7
+    { 19, 25, 28, 21, 29, 30, 13, 14,  8 }, // 8
+    { 19, 25, 28, 21, 31, 32, 13, 14,  8 }, // 9
+    { 19, 25, 28, 21, 33, 34, 13, 14, 35 }, // 10
+    { 19, 25, 28, 21, 36, 37, 13, 38, 39 }, // 11
+    { 19, 25, 28, 21, 40, 37, 13, 41, 42 }  // 12
+  };
+  constexpr uint8_t vuBars[9][8] U8X8TILESR3_PROGMEM = { {0, 16, 0, 16, 0, 16, 0, 16}, {0, 16, 0, 16, 0, 16, 0, 124}, {0, 16, 0, 16, 0, 16, 124, 124}, {0, 16, 0, 16, 0, 124, 124, 124 }, {0, 16, 0, 16, 124, 124, 124, 124}, {0, 16, 0, 124, 124, 124, 124, 124}, {0, 16, 124, 124, 124, 124, 124, 124}, {0, 124, 124, 124, 124, 124, 124, 124 }, { 124, 124, 124, 124, 124, 124, 124, 124 } };
+  constexpr uint8_t letters4[27][4][8] U8X8TILESR3_PROGMEM = {{{0,3,7,28,56,56,112,127}, {0,192,224,56,28,28,14,254}, {127,96,96,96,96,96,96,96}, {254,6,6,6,6,6,6,6}}, // A
+    {{0,127,127,96,96,96,96,127}, {0,248,252,12,6,6,12,252}, {127,96,96,96,96,96,127,127}, {248,12,6,6,6,12,252,248}}, // B
+    {{0,15,31,56,112,96,96,96}, {0,248,252,14,6,6,0,0}, {96,96,96,96,112,56,31,15}, {0,0,0,6,6,14,252,248}}, // C
+    {{0,127,127,96,96,96,96,96},{0,248,252,12,6,6,6,6}, {96,96,96,96,96,96,127,127}, {6,6,6,6,6,12,252,248}}, // D
+    {{0,127,127,96,96,96,96,127}, {0,254,254,0,0,0,0,248}, {127,96,96,96,96,96,127,127}, {248,0,0,0,0,0,254,254}}, // E
+    {{0,127,127,96,96,96,96,127}, {0,254,254,0,0,0,0,248}, {127,96,96,96,96,96,96,96}, {248,0,0,0,0,0,0,0}}, // F
+    {{0,31,63,112,96,96,96,96}, {0,254,254,0,0,0,0,124}, {96,96,96,96,96,112,63,31}, {126,6,6,6,6,14,254,252}}, // G
+    {{0,96,96,96,96,96,96,127}, {0,6,6,6,6,6,6,254}, {127,96,96,96,96,96,96,96}, {254,6,6,6,6,6,6,6}}, // H
+    {{0,31,31,1,1,1,1,1}, {0,248,248,128,128,128,128,128}, {1,1,1,1,1,1,31,31}, {128,128,128,128,128,128,248,248}}, // I
+    {{0,0,0,0,0,0,0,0}, {0,62,62,6,6,6,6,6}, {0,0,0,96,96,112,63,31}, {6,6,6,6,6,12,252,248}}, // J
+    {{0,96,96,96,97,103,126,120}, {0,6,30,120,224,128,0,0}, {120,124,102,103,97,96,96,96}, {0,0,0,128,224,120,30,6}}, // K
+    {{0,96,96,96,96,96,96,96}, {0,0,0,0,0,0,0,0}, {96,96,96,96,96,96,127,127}, {0,0,0,0,0,0,254,254}}, // L
+    {{0,96,120,126,103,97,97,97}, {0,6,30,126,230,134,134,134}, {96,96,96,96,96,96,96,96}, {6,6,6,6,6,6,6,6}}, // M
+    {{0,96,96,96,120,126,103,97}, {0,6,6,6,6,6,134,230}, {96,96,96,96,96,96,96,96},{126,30,6,6,6,6,6,6}}, // N
+    {{0,31,63,112,96,96,96,96}, {0,252,254,14,6,6,6,6}, {96,96,96,96,96,112,63,31}, {6,6,6,6,6,14,254,252}}, // O
+    {{0,127,127,96,96,96,96,127}, {0,252,254,14,6,6,14,252}, {127,96,96,96,96,96,96,96}, {248,0,0,0,0,0,0,0}}, // P
+    {{0,31,63,112,96,96,96,96}, {0,252,254,14,6,6,6,6}, {96,96,96,96,96,112,63,31}, {6,198,230,118,62,30,254,252}}, // Q
+    {{0,127,127,96,96,96,96,127}, {0,248,252,12,6,6,12,252}, {127,124,111,99,96,96,96,96}, {248,0,0,192,240,60,14,6}}, // R
+    {{0,31,63,112,96,96,96,63}, {0,248,252,14,6,0,0,252}, {31,0,0,0,96,112,63,31}, {254,14,6,6,6,14,252,248}}, // S
+    {{0,127,127,1,1,1,1,1}, {0,254,254,128,128,128,128,128}, {1,1,1,1,1,1,1,1}, {128,128,128,128,128,128,128,128}}, // T
+    {{0,96,96,96,96,96,96,96}, {0,6,6,6,6,6,6,6}, {96,96,96,96,96,112,63,31}, {6,6,6,6,6,14,254,252}}, // U
+    {{0,96,96,96,96,96,96,96}, {0,6,6,6,6,6,6,6}, {96,96,96,112,56,30,7,1}, {6,6,6,14,28,120,224,128}}, // V
+    {{0,96,96,96,96,96,96,96}, {0,6,6,6,6,6,6,6}, {96,96,97,97,103,126,120,96}, {6,6,134,134,230,126,30,6}}, // W
+    {{0,96,96,96,96,120,30,7}, {0,6,6,6,6,30,120,224}, {1,7,30,120,96,96,96,96}, {224,248,30,6,6,6,6,6}}, //X
+    {{0,96,96,96,96,120,30,7}, {0,6,6,6,6,30,120,224}, {1,1,1,1,1,1,1,1}, {128,128,128,128,128,128,128,128}}, // Y
+    {{0,127,127,0,0,0,0,1}, {0,254,254,6,6,30,120,224}, {7,30,120,96,96,96,127,127}, {128,0,0,0,0,0,254,254}}, // Z
+    {{0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}}}; // space
+  constexpr uint8_t symbols[4][8] U8X8TILESR3_PROGMEM = {{0, 0, 0, 0, 255, 0, 0, 0}, {0, 0, 0, 24, 24, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 126, 0, 0, 0}};// dash, dot, blank, negative
+  constexpr uint8_t heightMarks[8][8] U8X8TILESR3_PROGMEM = {{0,0,0,0,0,0,0,126}, {0,0,0,0,0,0,126,0}, {0,0,0,0,0,126,0,0}, {0,0,0,0,126,0,0,0}, 
+    {0,0,0,126,0,0,0,0}, {0,0,126,0,0,0,0,0}, {0,126,0,0,0,0,0,0}, {126,0,0,0,0,0,0,0}}; // hight marks
+  constexpr uint8_t numbers[10][8] U8X8TILESR3_PROGMEM = {{0, 56, 68, 68, 68, 68, 56, 0}, {0, 48, 80, 16, 16, 16, 124, 0},
+    {0, 56, 68, 8, 16, 32, 124}, {0, 56, 68, 4, 24, 68, 56, 0}, {0, 8, 24, 40, 72, 124, 8, 0},
+    {0, 124, 64, 56, 4, 68, 56, 0}, {0, 56, 64, 120, 68, 68, 56, 0}, {0, 124, 4, 8, 16, 32, 64, 0},
+    {0, 56, 68, 56, 68, 68, 56, 0}, {0, 56, 68, 68, 60, 4, 56, 0}}; // numbers
+  constexpr uint8_t letters[27][8] U8X8TILESR3_PROGMEM = {{0,56,68,68,124,68,68,0}, {0,120,68,68,120,68,124,0}, {0,56,68,64,64,68,56,0}, {0,120,68,68,68,68,120,0}, // A,B,C,D
+    {0,124,64,64,120,64,124,0}, {0,124,64,64,120,64,64,0}, {0,56,68,64,92,68,56,0}, {0,68,68,68,124,68,68,0}, // E,F,G,H
+    {0,124,16,16,16,16,124,0}, {0,4,4,4,4,68,56,0}, {0,68,72,112,112,72,68,0}, {0,64,64,64,64,64,124,0}, //I,J,K,L
+    {0,68,108,84,68,68,68,0}, {0,68,100,84,76,68,68,0}, {0,56,68,68,68,68,56,0}, {0,120,68,68,120,64,64,0}, //M,N,O,P
+    {0,56,68,68,84,76,60,0}, {0,120,68,68,120,72,68,0}, {0,56,68,32,24,68,56,0}, {0,124,16,16,16,16,16,0}, //Q,R,S,T
+    {0,68,68,68,68,68,56,0}, {0,68,68,68,68,40,16,0}, {0,68,68,84,84,84,40,0}, {0,68,68,40,16,40,68,0}, //U,V,W,  
+    {0,68,68,40,16,16,16,0}, {0,124,4,8,16,32,124,0}, {0,0,0,0,0,0,0,0}}; //Y,Z,space
+  // overlay masks in Overlay bit order: dim (AND), bar and underline (OR), cursor (XOR)
+  constexpr uint8_t overlays[4][8] U8X8TILESR3_PROGMEM = {{170,85,170,85,170,85,170,85}, {0,1,0,1,0,1,0,1}, {0,0,0,0,0,0,0,255}, {128,128,128,128,128,128,128,128}};
+  // glyph for each ASCII character: 0 - 25 letters (either case), 26 space, 0x80 | n digit n, 0xFF none
+  constexpr uint8_t ascii[128] U8X8TILESR3_PROGMEM = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0 - 15
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 16 - 31
+    0x1A, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 32 - 47
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 48 - 63
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, // 64 - 79
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 80 - 95
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, // 96 - 111
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF  // 112 - 127
+  };
+}
+
+/* A font or glyph set generated by extras/glyphc from PBM or BDF sources.
+* Glyphs are width x height tiles drawn from a pool of unique tiles, shared by every
+* glyph set generated into the same header. A compressed pool stores each tile as a mask
+* byte, whose set bits (from bit 7 for row 0) repeat the previous row, followed by the
+* rows that are not repeats. The offset of every 8th tile is kept in blocks.
+* Pools of more than 256 tiles index them with 16 bits, in wideGlyphs instead of glyphs.
+*/
+struct U8x8TilesR3Font {
+  const uint8_t *tiles;   // pool, 8 bytes per tile, or the compressed pool
+  const uint16_t *blocks; // offset of every 8th compressed tile, nullptr when the pool is plain
+  const uint8_t *glyphs;  // pool index of each tile of each glyph, row by row, nullptr when wide
+  uint8_t first;          // character code of the first glyph
+  uint16_t count;         // number of glyphs, up to 256
+  uint8_t width;          // glyph size in tiles
+  uint8_t height;
+  const uint16_t *wideGlyphs; // as glyphs for a pool of more than 256 tiles, else nullptr
+
+  /* Copy tile t (row by row) of glyph g into an 8-byte buffer */
+  void readTile(uint8_t *tile, uint8_t g, uint8_t t) const {
+    uint16_t i = g * width * height + t;
+    uint16_t index = wideGlyphs ? U8X8TILESR3_READ_WORD(wideGlyphs + i) : U8X8TILESR3_READ_BYTE(glyphs + i);
+    if (!blocks) {
+      U8X8TILESR3_READ_TILE(tile, tiles + index * 8);
+      return;
+    }
+    const uint8_t *src = tiles + U8X8TILESR3_READ_WORD(blocks + index / 8);
+    for (uint8_t k = index & 7; k > 0; k--) {
+      src += 9 - __builtin_popcount(U8X8TILESR3_READ_BYTE(src));
+    }
+    uint8_t mask = U8X8TILESR3_READ_BYTE(src++);
+    uint8_t row = 0;
+    for (uint8_t i = 0; i < 8; i++, mask <<= 1) {
+      if (!(mask & 0x80)) row = U8X8TILESR3_READ_BYTE(src++);
+      tile[i] = row;
+    }
+  }
+};
+
+/* An animation of width x height tile frames (up to 16 tiles) kept as the changes between frames.
+* For each frame in turn, deltas holds the number of tiles that differ from the frame before
+* (for frame 0, from the last frame, so it loops) followed by a position (row by row) and pool
+* index pair for each of them. key holds the pool index of every position in frame 0.
+* Any number of U8x8TilesR3Animator instances can play the same animation.
+*/
+struct U8x8TilesR3Animation {
+  const uint8_t *tiles;  // pool, 8 bytes per tile
+  const uint8_t *key;
+  const uint8_t *deltas;
+  uint8_t frames;
+  uint8_t width;
+  uint8_t height;
+
+  /* Offset in deltas of the changes into frame f */
+  uint16_t deltaOffset(uint8_t f) const {
+    uint16_t offset = 0;
+    for (uint8_t i = 0; i < f; i++) offset += 1 + 2 * U8X8TILESR3_READ_BYTE(deltas + offset);
+    return offset;
+  }
+};
+
+namespace U8x8TilesR3Glyphs {
+  // circle4 filling up and emptying again as it loops, e.g. a step sequencer LED
+  constexpr U8x8TilesR3Animation circle4Fill = { circle4Frames[0][0], circle4FillKey, circle4FillDeltas, 4, 2, 2 };
+}
+
+/* Position and frame of one playing animation */
+class U8x8TilesR3Animator {
+public:
+  U8x8TilesR3Animator(int x, int y) : x(x), y(y) { }
+
+  /* Time between frames for updateAnimation(), in microseconds (at least 1) */
+  void setInterval(unsigned long us) {
+    interval = us ? us : 1;
+  }
+
+  /* Forget what is on the display so the next draw sends every tile */
+  void reset() {
+    drawn = false;
+  }
+
+  int x;
+  int y;
+  uint8_t frame = 0;              // frame on the display
+  uint16_t next = 0;              // offset in deltas of the changes into the following frame
+  unsigned long interval = 100000;
+  unsigned long lastStep = 0;
+  bool drawn = false;
+};
+
+/* Tile tables for a square N-tile dial.
+* Specialise this for other dial sizes (e.g. 4 or 16) with a tile pool
+* and a table of pool indices for each tile of each dial state.
+*/
+template <uint8_t N> struct U8x8TilesR3DialTiles;
+
+template <> struct U8x8TilesR3DialTiles<9> {
+  static constexpr uint8_t side = 3;
+  static constexpr uint8_t states = 13;
+  static const uint8_t *tile(uint8_t i) { return U8x8TilesR3Glyphs::dial9Tiles[i]; }
+  static uint8_t index(uint8_t state, uint8_t t) { return U8X8TILESR3_READ_BYTE(&U8x8TilesR3Glyphs::dial9States[state][t]); }
+};
+
+/* Number of the first K dial thresholds reached by val, for a dial of STEPS + 1 states.
+* Threshold k is ceil(k / 0.0118) for the 13-state dial, the mapping of the original val * 0.0118,
+* so the last state starts at 1017; other sizes spread the same range over their states.
+* Each threshold is a compile-time constant, so this unrolls into K integer compares.
+*/
+template <uint8_t K, uint8_t STEPS> struct U8x8TilesR3DialSteps {
+  static uint8_t count(int val) {
+    return (val >= (int)((K * 120000L + 118L * STEPS - 1) / (118L * STEPS))) + U8x8TilesR3DialSteps<K - 1, STEPS>::count(val);
+  }
+};
+
+template <uint8_t STEPS> struct U8x8TilesR3DialSteps<0, STEPS> {
+  static uint8_t count(int) { return 0; }
+};
+
+/* A square N-tile dial that remembers the state it last drew,
+* so drawDial() only sends the tiles that differ from it
+*/
+template <uint8_t N> class U8x8TilesR3Dial {
+public:
+  typedef U8x8TilesR3DialTiles<N> Tiles;
+
+  /* Dial state, 0 to Tiles::states - 1, for val from 0 to 1024 */
+  static uint8_t stateOf(int val) {
+    return U8x8TilesR3DialSteps<Tiles::states - 1, Tiles::states - 1>::count(val);
+  }
+
+  /* Forget the last state so the next draw sends every tile */
+  void reset() {
+    last = 0xFF;
+  }
+
+  uint8_t last = 0xFF; // state on the display, 0xFF when unknown
+};
+
+/* Fixed-point number formatting into tile codes, shared by the number fields.
+* A format is the number of decimal places (0 - 7) in the value, optionally with SCALE,
+* e.g. value 1234 with format 2 shows 12.34.
+*/
+struct U8x8TilesR3Number {
+  enum : uint8_t { DECIMALS = 0x07, SCALE = 0x08 };
+  enum Code : uint8_t { BLANK = 10, DOT, NEGATIVE, KILO, MEGA, TOO_WIDE };
+
+  /* Render value right-aligned into width tile codes (0 - 9 for digits).
+  * Decimal places are dropped, truncating, until the value fits, and the 0 before
+  * the point only when it has to be. With SCALE a value that still does not fit is
+  * shown in thousands (K) or millions (M), with one decimal place if there is room,
+  * e.g. 1.5K. A value that cannot fit shows dashes.
+  */
+  static void render(uint8_t *codes, uint8_t width, long value, uint8_t format) {
+    renderAs<unsigned long>(codes, width, value, format);
+  }
+
+  /* render() with the arithmetic done in unsigned type U, e.g. uint32_t as on AVR */
+  template <class U> static void renderAs(uint8_t *codes, uint8_t width, long value, uint8_t format) {
+    if (width == 0) return;
+    bool neg = value < 0;
+    U mag = neg ? U(0) - (U)value : (U)value;
+    uint8_t decimals = format & DECIMALS;
+    uint8_t suffixes = (format & SCALE) ? 3 : 1;
+    for (uint8_t suffix = 0; suffix < suffixes; suffix++) {
+      uint8_t places = decimals + suffix * 3;
+      uint8_t room = width - neg - (suffix > 0);
+      if (room > width) break;
+      U whole = dropDigits(mag, places);
+      uint8_t digits = countDigits(whole);
+      if (digits > room) continue;
+      room -= digits;
+      uint8_t shown = room >= 2 ? room - 1 : 0;
+      uint8_t cap = suffix ? 1 : decimals;
+      if (shown > cap) shown = cap;
+      bool zero = digits == 0 && (shown == 0 || shown + 1 < room);
+      U n = dropDigits(mag, places - shown);
+      if (n == 0 && suffix) continue; // a small negative value scaled down to 0K
+      if (n == 0) neg = false;
+      // fill from the right: suffix, decimals, point, whole part, sign, blanks
+      uint8_t i = width;
+      if (suffix) codes[--i] = suffix == 1 ? KILO : MEGA;
+      for (uint8_t d = 0; d < shown; d++, n /= 10) codes[--i] = n % 10;
+      if (shown) codes[--i] = DOT;
+      if (digits) {
+        for (; n; n /= 10) codes[--i] = n % 10;
+      } else if (zero) {
+        codes[--i] = 0;
+      }
+      if (neg) codes[--i] = NEGATIVE;
+      while (i) codes[--i] = BLANK;
+      return;
+    }
+    memset(codes, TOO_WIDE, width);
+  }
+
+private:
+  template <class U> static U power10(uint8_t e) {
+    U p = 1;
+    while (e--) p *= 10;
+    return p;
+  }
+
+  /* n with its last e digits dropped. With SCALE e reaches 13, past the 10^9 that
+  * 32 bits can hold, so larger e divide in two steps.
+  */
+  template <class U> static U dropDigits(U n, uint8_t e) {
+    if (e > 9) {
+      n /= power10<U>(9);
+      e -= 9;
+    }
+    return n / power10<U>(e);
+  }
+
+  /* Digits of n, none for 0 */
+  template <class U> static uint8_t countDigits(U n) {
+    uint8_t digits = 0;
+    for (; n; n /= 10) digits++;
+    return digits;
+  }
+};
+
+/* A number field W tiles wide that remembers the tile codes it last drew,
+* so drawNumberField() only sends the digits that changed
+*/
+template <uint8_t W> class U8x8TilesR3NumberField {
+public:
+  U8x8TilesR3NumberField() {
+    reset();
+  }
+
+  /* Forget what is on the display so the next draw sends every tile */
+  void reset() {
+    memset(last, 0xFF, W);
+  }
+
+  uint8_t last[W]; // codes on the display, 0xFF when unknown
+};
+
+/* A vertical VU meter of length tiles that remembers what it last drew,
+* so drawVUMeter() only sends the tiles whose segments changed.
+* The level runs from 0 to length * 8, one step per pixel row.
+*/
+class U8x8TilesR3VUMeter {
+public:
+  U8x8TilesR3VUMeter(int x, int y, uint8_t length = 5) : x(x), y(y), length(length) { }
+
+  /* Show a peak marker held for the given number of updates before it falls one step per update, 0 for none */
+  void setPeakHold(uint8_t updates) {
+    hold = updates;
+    if (!hold) peak = 0;
+  }
+
+  /* Let the level fall at most steps per update, 0 to follow the input directly */
+  void setDecay(uint8_t steps) {
+    decay = steps;
+  }
+
+  /* Forget what is on the display so the next draw sends every tile */
+  void reset() {
+    drawn = false;
+  }
+
+  /* Move the shown level and peak towards val */
+  void update(int val) {
+    uint8_t top = length * 8;
+    uint8_t target = val < 0 ? 0 : (val > top ? top : val);
+    if (target >= level || decay == 0 || level - target <= decay) level = target;
+    else level -= decay;
+    if (!hold) return;
+    if (level >= peak) {
+      peak = level;
+      holdCount = hold;
+    } else if (holdCount) {
+      holdCount--;
+    } else {
+      peak--;
+    }
+  }
+
+  /* Segment state of tile k, counted up from the bottom, for a level and peak:
+  * fill 0 - 8 in the low nibble, the peak marker position 1 - 8 in the high nibble
+  */
+  uint8_t tileState(uint8_t k, uint8_t lev, uint8_t pk) const {
+    uint8_t base = k * 8;
+    uint8_t state = lev <= base ? 0 : (lev - base >= 8 ? 8 : lev - base);
+    if (pk > lev && pk > base && pk <= base + 8) state |= (pk - base) << 4;
+    return state;
+  }
+
+  int x;
+  int y;
+  uint8_t length;
+  uint8_t level = 0; // level on the display
+  uint8_t peak = 0;  // peak marker on the display, shown when above level
+  uint8_t hold = 0;
+  uint8_t holdCount = 0;
+  uint8_t decay = 0;
+  bool drawn = false;
+};
+
+/* A line of single-tile or large (2 x 2) letters and digits that scrolls left through a window of
+* length tiles (up to 16) a pixel at a time, followed by gap blank tiles before it repeats.
+* Text that fits in the window is shown still. The text is kept by pointer, not copied.
+*/
+class U8x8TilesR3Marquee {
+public:
+  U8x8TilesR3Marquee(int x, int y, uint8_t length, bool large = false)
+    : x(x), y(y), length(length < 16 ? length : 16), large(large) { }
+
+  /* Scroll text held in RAM, or in PROGMEM when flash is set, from its start */
+  void setText(const char *str, bool flash = false) {
+    text = str;
+    inFlash = flash;
+    textLength = 0;
+    while (flash ? U8X8TILESR3_READ_BYTE(str + textLength) : str[textLength]) textLength++;
+    offset = 0;
+    drawn = false;
+  }
+
+#if defined(ARDUINO)
+  void setText(const __FlashStringHelper *str) {
+    setText((const char *)str, true);
+  }
+#endif
+
+  /* Scrolling speed, in pixels per second */
+  void setRate(uint16_t pixelsPerSecond) {
+    interval = 1000000UL / (pixelsPerSecond ? pixelsPerSecond : 1);
+  }
+
+  /* Blank tiles between the end of the text and its start coming round again */
+  void setGap(uint8_t tiles) {
+    gap = tiles;
+  }
+
+  /* Forget what is on the display so the next update draws the window */
+  void reset() {
+    drawn = false;
+  }
+
+  /* Tiles across the text takes */
+  uint16_t textTiles() const {
+    return textLength * (large ? 2 : 1);
+  }
+
+  bool scrolls() const {
+    return textTiles() > length;
+  }
+
+  int x;
+  int y;
+  uint8_t length;
+  bool large;
+  const char *text = "";
+  bool inFlash = false;
+  uint16_t textLength = 0;
+  uint8_t gap = 4;
+  uint16_t offset = 0;            // pixel of the text at the left edge of the window
+  unsigned long interval = 25000; // microseconds per pixel
+  unsigned long lastStep = 0;
+  bool drawn = false;
+};
+
+#if U8X8TILESR3_STATS
+/* Counters kept per group of draw functions. Tiles are counted against the outermost draw call
+* that queued them, also when they are sent later by flush() or service(); SEND counts the calls
+* to those two.
+*/
+struct U8x8TilesR3Stats {
+  enum Api : uint8_t { OTHER, NUMBER, FIELD, LETTER, WORD, LARGE, SYMBOL, GLYPH, DIAL, VU, CHART, FONT, FILL, SEND, COUNT };
+
+  struct Counters {
+    uint32_t calls;     // outermost calls
+    uint32_t tiles;     // tiles sent
+    uint32_t skipped;   // tiles not sent because the shadow shows them already on the panel
+    uint32_t bytes;     // tile data bytes sent
+    uint32_t transfers; // drawTile calls
+    uint32_t micros;    // time spent in drawTile
+  };
+
+  Counters api[COUNT];
+  uint32_t frames;      // frames marked with endFrame()
+  uint32_t transferMin; // shortest and longest single drawTile call, in microseconds
+  uint32_t transferMax;
+
+  void reset() {
+    memset(this, 0, sizeof(*this));
+    transferMin = 0xFFFFFFFF;
+  }
+
+  /* Totals of all groups */
+  Counters total() const {
+    Counters t = {};
+    for (uint8_t a = 0; a < COUNT; a++) {
+      t.calls += api[a].calls;
+      t.tiles += api[a].tiles;
+      t.skipped += api[a].skipped;
+      t.bytes += api[a].bytes;
+      t.transfers += api[a].transfers;
+      t.micros += api[a].micros;
+    }
+    return t;
+  }
+
+  /* Name of a group, in PROGMEM */
+  static const char *name(uint8_t a) {
+    static const char names[COUNT + 1][7] U8X8TILESR3_PROGMEM = { "other", "number", "field", "letter", "word",
+                                                                  "large", "symbol", "glyph", "dial", "vu", "chart",
+                                                                  "font", "fill", "send", "" };
+    return names[a < COUNT ? a : (uint8_t)COUNT];
+  }
+
+  /* Print a table of the groups that were used, then per-frame totals, to Serial or any Print */
+  template <class Out> void print(Out &out) const {
+    out.println(U8X8TILESR3_TEXT("api calls tiles skipped bytes transfers us"));
+    for (uint8_t a = 0; a <= COUNT; a++) {
+      Counters c = a < COUNT ? api[a] : total();
+      if (a < COUNT && c.calls == 0 && c.transfers == 0) continue;
+      if (a < COUNT) out.print(U8X8TILESR3_FLASH_TEXT(name(a)));
+      else out.print(U8X8TILESR3_TEXT("total"));
+      uint32_t values[6] = { c.calls, c.tiles, c.skipped, c.bytes, c.transfers, c.micros };
+      for (uint8_t i = 0; i < 6; i++) {
+        out.print(' ');
+        out.print((unsigned long)values[i]);
+      }
+      out.println();
+    }
+    Counters t = total();
+    out.print(U8X8TILESR3_TEXT("transfer us min/avg/max "));
+    out.print((unsigned long)(t.transfers ? transferMin : 0));
+    out.print('/');
+    out.print((unsigned long)(t.transfers ? t.micros / t.transfers : 0));
+    out.print('/');
+    out.println((unsigned long)transferMax);
+    if (frames) {
+      out.print(U8X8TILESR3_TEXT("per frame: tiles "));
+      out.print((unsigned long)(t.tiles / frames));
+      out.print(U8X8TILESR3_TEXT(", bytes "));
+      out.print((unsigned long)(t.bytes / frames));
+      out.print(U8X8TILESR3_TEXT(", us "));
+      out.println((unsigned long)(t.micros / frames));
+    }
+  }
+};
+#endif
+
+/* Base of the retained widgets drawn by U8x8TilesR3Screen.
+* A widget covers a rectangle of the tile grid, is allocated statically by the sketch,
+* and is only drawn by render() after something about it has changed.
+*/
+class U8x8TilesR3Widget {
+public:
+  enum Type : uint8_t { LABEL, NUMBER, DIAL, VUBAR, ICON, CHART };
+
+  /* Show or hide the widget, a hidden widget's tiles are cleared by the next render */
+  void setVisible(bool on) {
+    if (on == visible) return;
+    visible = on;
+    dirty |= on ? DIRTY_ALL : DIRTY_CLEAR;
+  }
+
+  /* Draw every tile of the widget on the next render */
+  void invalidate() {
+    dirty |= DIRTY_ALL;
+  }
+
+  bool overlaps(const U8x8TilesR3Widget &w) const {
+    return x < w.x + w.width && w.x < x + width && y < w.y + w.height && w.y < y + height;
+  }
+
+  const Type type;
+  const int8_t x;
+  const int8_t y;
+  const uint8_t width;
+  const uint8_t height;
+
+protected:
+  U8x8TilesR3Widget(Type type, int8_t x, int8_t y, uint8_t width, uint8_t height)
+    : type(type), x(x), y(y), width(width), height(height) { }
+
+  enum : uint8_t { DIRTY_VALUE = 1, DIRTY_ALL = 2, DIRTY_CLEAR = 4 };
+  uint8_t dirty = DIRTY_ALL;
+  bool visible = true;
+  U8x8TilesR3Widget *next = nullptr; // next widget up on its screen
+
+  template <class> friend class U8x8TilesR3Screen;
+};
+
+/* A word of length single-tile letters and digits, e.g. a menu item */
+class U8x8TilesR3LabelWidget : public U8x8TilesR3Widget {
+public:
+  U8x8TilesR3LabelWidget(int8_t x, int8_t y, uint8_t length, const char *text = "")
+    : U8x8TilesR3Widget(LABEL, x, y, length, 1), text(text) { }
+
+  /* Show text, which is kept by pointer; call invalidate() after changing it in place */
+  void set(const char *str) {
+    if (str == text) return;
+    text = str;
+    dirty |= DIRTY_VALUE;
+  }
+
+  /* Overlays for every tile, e.g. U8x8TilesR3::OVERLAY_INVERT when selected */
+  void setOverlays(uint8_t o) {
+    if (o == overlays) return;
+    overlays = o;
+    dirty |= DIRTY_VALUE;
+  }
+
+  const char *text;
+  uint8_t overlays = 0;
+};
+
+/* A number field up to 8 tiles wide, in a U8x8TilesR3Number format */
+class U8x8TilesR3NumberWidget : public U8x8TilesR3Widget {
+public:
+  static const uint8_t MAX_WIDTH = 8;
+
+  U8x8TilesR3NumberWidget(int8_t x, int8_t y, uint8_t width, uint8_t format = 0)
+    : U8x8TilesR3Widget(NUMBER, x, y, width < MAX_WIDTH ? width : MAX_WIDTH, 1), format(format) { }
+
+  void set(long v) {
+    if (v == value) return;
+    value = v;
+    dirty |= DIRTY_VALUE;
+  }
+
+  long value = 0;
+  uint8_t format;
+  uint8_t last[MAX_WIDTH]; // codes on the display, rewritten by a full draw
+};
+
+/* A nine-tile (3 x 3) dial showing a value from 0 to 1024 */
+class U8x8TilesR3DialWidget : public U8x8TilesR3Widget {
+public:
+  U8x8TilesR3DialWidget(int8_t x, int8_t y) : U8x8TilesR3Widget(DIAL, x, y, 3, 3) { }
+
+  /* Only a value in a different dial state marks the widget dirty */
+  void set(int v) {
+    if (dial.stateOf(v) != dial.stateOf(value)) dirty |= DIRTY_VALUE;
+    value = v;
+  }
+
+  int value = 0;
+  U8x8TilesR3Dial<9> dial;
+};
+
+/* A vertical VU meter of length tiles, see U8x8TilesR3VUMeter.
+* With peak hold or decay, set the level every frame so the meter keeps moving.
+*/
+class U8x8TilesR3VUBarWidget : public U8x8TilesR3Widget {
+public:
+  U8x8TilesR3VUBarWidget(int8_t x, int8_t y, uint8_t length = 5)
+    : U8x8TilesR3Widget(VUBAR, x, y, 1, length), meter(x, y, length) { }
+
+  void set(int v) {
+    value = v;
+    dirty |= DIRTY_VALUE;
+  }
+
+  int value = 0;
+  U8x8TilesR3VUMeter meter;
+};
+
+/* A glyph of width x height tiles from a table in the library's tile order, e.g. circle4.
+* The table must be in PROGMEM like the library's own glyphs.
+*/
+class U8x8TilesR3IconWidget : public U8x8TilesR3Widget {
+public:
+  U8x8TilesR3IconWidget(int8_t x, int8_t y, uint8_t width, uint8_t height, const uint8_t (*tiles)[8])
+    : U8x8TilesR3Widget(ICON, x, y, width, height), tiles(tiles) { }
+
+  /* Show another glyph of the same size */
+  void set(const uint8_t (*t)[8]) {
+    if (t == tiles) return;
+    tiles = t;
+    dirty |= DIRTY_VALUE;
+  }
+
+  void setOverlays(uint8_t o) {
+    if (o == overlays) return;
+    overlays = o;
+    dirty |= DIRTY_VALUE;
+  }
+
+  const uint8_t (*tiles)[8];
+  uint8_t overlays = 0;
+};
+
+/* A scrolling strip chart of width x height tiles with one pixel column per sample, newest on the right.
+* Each column is a span from a low to a high level, from 0 at the bottom to height * 8 - 1 at the top,
+* so a single value plots a point and a min/max pair an envelope.
+* Storage is provided by U8x8TilesR3StripChart<W, H>; draw it with a screen or drawChart().
+*/
+class U8x8TilesR3ChartWidget : public U8x8TilesR3Widget {
+public:
+  /* SCROLL_PIXEL moves the chart one pixel per column. SCROLL_TILE fills the last tile and then
+  * moves the chart a whole tile, so between steps only the tiles of the newest column are sent.
+  */
+  enum Scroll : uint8_t { SCROLL_PIXEL, SCROLL_TILE };
+
+  /* Add a sample. With n samples per column, a column is added for every n samples,
+  * spanning their lowest to highest level.
+  */
+  void add(int level) {
+    uint8_t l = clampLevel(level);
+    if (collected == 0 || l < low) low = l;
+    if (collected == 0 || l > high) high = l;
+    if (++collected < perColumn) return;
+    collected = 0;
+    push(low, high);
+  }
+
+  /* Add a column spanning low to high, e.g. the min and max of a block of audio samples */
+  void add(int lowLevel, int highLevel) {
+    uint8_t l = clampLevel(lowLevel);
+    uint8_t h = clampLevel(highLevel);
+    push(l < h ? l : h, l < h ? h : l);
+  }
+
+  /* Number of samples collected into the span of each column by add(level), 1 to plot every sample */
+  void setSamplesPerColumn(uint8_t n) {
+    perColumn = n ? n : 1;
+    collected = 0;
+  }
+
+  void setScroll(Scroll s) {
+    if (s == scroll) return;
+    scroll = s;
+    drawn = false;
+    dirty |= DIRTY_VALUE;
+  }
+
+  /* Remove every column */
+  void clear() {
+    start = count = phase = collected = 0;
+    drawn = false;
+    dirty |= DIRTY_VALUE;
+  }
+
+  /* Span of pixel column c of the chart (0 on the left), false when the column is empty */
+  bool span(uint8_t c, uint8_t &lowLevel, uint8_t &highLevel) const {
+    uint8_t e = end();
+    if (c >= e) return false;
+    return sample(e - c, lowLevel, highLevel);
+  }
+
+protected:
+  U8x8TilesR3ChartWidget(int8_t x, int8_t y, uint8_t width, uint8_t height, uint8_t (*spans)[2])
+    : U8x8TilesR3Widget(CHART, x, y, width, height), spans(spans) { }
+
+  uint8_t (*const spans)[2];  // ring of width * 8 columns, low and high level
+  bool drawn = false;         // the display shows the columns as of the last draw
+  Scroll scroll = SCROLL_PIXEL;
+  uint8_t start = 0;          // oldest column in the ring
+  uint8_t count = 0;
+  uint8_t phase = 0;          // columns added mod 8, for SCROLL_TILE
+  uint8_t perColumn = 1;
+  uint8_t collected = 0;
+  uint8_t low = 0;
+  uint8_t high = 0;
+  uint8_t drawnEnd = 0;       // end() and count at the last draw
+  uint8_t drawnCount = 0;
+  uint8_t pushed = 0;         // columns added since the last draw, up to 255
+
+  uint8_t clampLevel(int level) const {
+    return level < 0 ? 0 : (level >= height * 8 ? height * 8 - 1 : level);
+  }
+
+  // One past the pixel column of the newest column
+  uint8_t end() const {
+    uint8_t capacity = width * 8;
+    // SCROLL_TILE keeps the newest column in the last tile, after the columns added since the last step
+    return scroll == SCROLL_TILE ? capacity - 8 + (phase ? phase : 8) : capacity;
+  }
+
+  // Span of the column added age columns ago, 1 for the newest
+  bool sample(uint16_t age, uint8_t &lowLevel, uint8_t &highLevel) const {
+    if (age == 0 || age > count) return false;
+    uint8_t capacity = width * 8;
+    uint8_t i = start + count - age;
+    const uint8_t *s = spans[i < capacity ? i : i - capacity];
+    lowLevel = s[0];
+    highLevel = s[1];
+    return true;
+  }
+
+  void push(uint8_t lowLevel, uint8_t highLevel) {
+    uint8_t capacity = width * 8;
+    uint8_t i = start + count;
+    if (count < capacity) count++;
+    else start = start + 1 < capacity ? start + 1 : 0;
+    uint8_t *s = spans[i < capacity ? i : i - capacity];
+    s[0] = lowLevel;
+    s[1] = highLevel;
+    phase = (phase + 1) & 7;
+    if (pushed < 255) pushed++;
+    dirty |= DIRTY_VALUE;
+  }
+
+  template <class> friend class U8x8TilesR3Panel;
+  template <class> friend class U8x8TilesR3Screen;
+};
+
+/* Strip chart storage for W tiles across (up to 16) and H tiles high (up to 16):
+* 2 bytes per pixel column, e.g. 256 bytes for 16 tiles across
+*/
+template <uint8_t W, uint8_t H>
+class U8x8TilesR3StripChart : public U8x8TilesR3ChartWidget {
+  static_assert(W >= 1 && W <= 16 && H >= 1 && H <= 16, "a strip chart is 1 to 16 tiles each way");
+public:
+  U8x8TilesR3StripChart(int8_t x, int8_t y) : U8x8TilesR3ChartWidget(x, y, W, H, columnSpans) { }
+
+private:
+  uint8_t columnSpans[W * 8][2];
+};
+
+/* Draws on one display through its u8x8 object, e.g. U8X8_SH1107_128X128_HW_I2C.
+* Display is the type the object is held as, so calls to it are direct and inline;
+* any number of panels share the glyph tables and each keeps its own shadow and queue.
+*/
+template <class Display> class U8x8TilesR3Panel {
 
 public:
 
  /** Constructor */
-  U8x8TilesR3() { };
+  explicit U8x8TilesR3Panel(Display &display) : u8x8(display) {
+#if U8X8TILESR3_STATS
+    counters.reset();
+#endif
+  };
+
+  /* Overlays combined with a glyph as it is drawn, any of them ORed together.
+  * DIM masks out every other pixel, BAR adds a dotted bar on the right, UNDERLINE a line
+  * along the bottom, CURSOR flips the left column and INVERT flips the whole tile.
+  */
+  enum Overlay : uint8_t { OVERLAY_NONE = 0, OVERLAY_DIM = 1, OVERLAY_BAR = 2, OVERLAY_UNDERLINE = 4, OVERLAY_CURSOR = 8, OVERLAY_INVERT = 16 };
+
+  // Overlays ORed together stay an Overlay, so they select the word functions that take no length
+  friend constexpr Overlay operator|(Overlay a, Overlay b) {
+    return static_cast<Overlay>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+  }
 
   /* Draw a single-tile number at the specified tile location on the display */
-  void drawNumber(int x, int y, int n) { 
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, numbers[n]);
+  void drawNumber(int x, int y, int n, uint8_t overlays = 0) { 
+    U8X8TILESR3_API(NUMBER);
+    putTile(x, y, U8x8TilesR3Glyphs::numbers[n], overlays);
   }
 
   /* Draw a four-tile (2 x 2) sized uppercase letter 
   * starting at the specified tile location on the display 
   */
   void drawLetter4(int x, int y, int l) {
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, letters4[l][0]);
-    u8x8.drawTile(y-yOffset, xOffset-1-x, 1, letters4[l][1]);
-    u8x8.drawTile(y-yOffset+1, xOffset-x, 1, letters4[l][2]);
-    u8x8.drawTile(y-yOffset+1, xOffset-1-x, 1, letters4[l][3]);
+    U8X8TILESR3_API(LARGE);
+    drawGlyph<2, 2>(x, y, U8x8TilesR3Glyphs::letters4[l]);
   }
 
   /* Draw a four-tile (2 x 2) open circle at the specified location. */
   void drawCircle4(int x, int y) {
-    u8x8.drawTile(y - yOffset, xOffset - x, 1, circle4[0]);
-    u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle4[1]);
-    u8x8.drawTile(y - yOffset+1, xOffset - x, 1, circle4[2]);
-    u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, circle4[3]);
+    drawGlyph<2, 2>(x, y, U8x8TilesR3Glyphs::circle4);
   }
 
   /* Draw a four-tile (2 x 2) semi-open circle at the specified location. */
   void drawCircle4_1(int x, int y) {
-    u8x8.drawTile(y - yOffset, xOffset - x, 1, circle4_1[0]);
-    u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle4_1[1]);
-    u8x8.drawTile(y - yOffset+1, xOffset - x, 1, circle4_1[2]);
-    u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, circle4_1[3]);
+    drawGlyph<2, 2>(x, y, U8x8TilesR3Glyphs::circle4_1);
   }
 
    /* Draw a four-tile (2 x 2) semi-filled circle at the specified location. */
   void drawCircle4_2(int x, int y) {
-    u8x8.drawTile(y - yOffset, xOffset - x, 1, circle4_2[0]);
-    u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle4_2[1]);
-    u8x8.drawTile(y - yOffset+1, xOffset - x, 1, circle4_2[2]);
-    u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, circle4_2[3]);
+    drawGlyph<2, 2>(x, y, U8x8TilesR3Glyphs::circle4_2);
   }
 
    /* Draw a four-tile (2 x 2) filled circle at the specified location. */
   void drawCircle4_3(int x, int y) {
-    u8x8.drawTile(y - yOffset, xOffset - x, 1, circle4_3[0]);
-    u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle4_3[1]);
-    u8x8.drawTile(y - yOffset+1, xOffset - x, 1, circle4_3[2]);
-    u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, circle4_3[3]);
+    drawGlyph<2, 2>(x, y, U8x8TilesR3Glyphs::circle4_3);
   }
 
   /* Draw a nine-tile (3 x 3) circle at the specified location. */
   void drawCircle9(int x, int y) {
-    u8x8.drawTile(y - yOffset, xOffset - x, 1, circle9[0]);
-    u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle9[1]);
-    u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, circle9[2]);
-    u8x8.drawTile(y - yOffset+1, xOffset - x, 1, circle9[3]);
-    u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, circle9[4]);
-    u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, circle9[5]);
-    u8x8.drawTile(y - yOffset+2, xOffset - x, 1, circle9[6]);
-    u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, circle9[7]);
-    u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
+    drawGlyphTiles<3, 3>(x, y, U8x8TilesR3Glyphs::circle9); // the first 9 tiles of dial9Tiles
+  }
+
+  /* Draw a W x H tile glyph, its tiles listed row by row in a PROGMEM table, at the specified tile location.
+  * Each column of the glyph lies along one display page and goes out as one transfer.
+  * When transparent is set, fully blank tiles are skipped and leave the display untouched.
+  */
+  template <uint8_t W, uint8_t H>
+  void drawGlyph(int x, int y, const uint8_t (&tiles)[W * H][8], bool transparent = false) {
+    drawGlyphTiles<W, H>(x, y, tiles, transparent);
+  }
+
+  /* Draw a glyph of width x height tiles, sized at run time, with any overlays.
+  * The tiles are read from PROGMEM, like the library's own glyphs.
+  */
+  void drawIcon(int x, int y, const uint8_t (*tiles)[8], uint8_t width, uint8_t height, uint8_t overlays = 0) {
+    U8X8TILESR3_API(GLYPH);
+    bool batch = openBatch();
+    for (uint8_t t = 0; t < width * height; t++) putTile(x + t % width, y + t / width, tiles[t], overlays);
+    closeBatch(batch);
   }
 
   /* Draw a nine-tile (3 x 3) dial at the specified location
   * displaying the value from 0 to 1024.
   */
-  void drawDial9(int x, int y, int val) {  // val 0 - 1024
-    int pos = val * 0.0118; // pos 0 _ 12
-    switch (pos) {
-      case 0:
-        drawCircle9(x, y);
-        break;
-      case 1:
-        drawCircle9(x, y);
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_1[0]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_1[1]);  // 7
-        break;
-      case 2:
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, circle9[0]);
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle9[1]);
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, circle9[2]);
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, circle9[5]);
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_2[0]);  // 3
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_2[1]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 3:
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, circle9[0]);
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle9[1]);
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, circle9[2]);
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, circle9[5]);
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_3[0]);  // 3
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_3[1]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 4:
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, circle9[0]);
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, circle9[1]);
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, circle9[2]);
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, circle9[5]);
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_4[0]);  // 3
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_4[1]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 5:
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, circle9[2]);
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, circle9[5]);
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);  // 0
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_5[1]);  // 1
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);  // 3
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_5[3]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 6:
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, circle9[2]);
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, circle9[5]);
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_6[0]);  // 1
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_6[1]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);  // 0
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);  // 3
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 7:
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, circle9[5]);
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_7[0]);  // 1
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, dial9_7[1]);  // 2
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_7[2]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);  // 0
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);  // 3
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 8:
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, dial9_8[0]);  // 2
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_8[1]);  // 4
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, dial9_8[2]);  // 5
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);  // 0
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_7[0]);  // 1
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);  // 3
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 9:
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, circle9[8]);
-        //
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_9[0]);  // 4
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, dial9_9[1]);  // 5
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);  // 6
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);  // 0
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_7[0]);  // 1
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, dial9_8[0]);  // 2
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);  // 3
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);  // 7
-        break;
-      case 10:
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_10[0]);  // 4
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, dial9_10[1]);  // 5
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, dial9_10[2]);  // 8
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);   // 6
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);   // 0
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_7[0]);   // 1
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, dial9_8[0]);   // 2
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);   // 3
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_2[3]);   // 7
-        break;
-      case 11:
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_11[0]);  // 4
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, dial9_11[1]);  // 5
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_11[2]);  // 7
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, dial9_11[3]);  // 8
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);   // 6
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);   // 0
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_7[0]);   // 1
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, dial9_8[0]);   // 2
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);   // 3
+  void drawDial9(int x, int y, int val) {
+    U8x8TilesR3Dial<9> dial;
+    drawDial(x, y, dial, val);
+  }
 
-        break;
-      case 12:
-        u8x8.drawTile(y - yOffset+1, xOffset-1 - x, 1, dial9_12[0]);  // 4
-        u8x8.drawTile(y - yOffset+2, xOffset-1 - x, 1, dial9_12[1]);  // 7
-        u8x8.drawTile(y - yOffset+2, xOffset-2 - x, 1, dial9_12[2]);  // 8
-        u8x8.drawTile(y - yOffset+2, xOffset - x, 1, dial9_2[2]);   // 6
-        u8x8.drawTile(y - yOffset, xOffset - x, 1, dial9_5[0]);   // 0
-        u8x8.drawTile(y - yOffset, xOffset-1 - x, 1, dial9_7[0]);   // 1
-        u8x8.drawTile(y - yOffset, xOffset-2 - x, 1, dial9_8[0]);   // 2
-        u8x8.drawTile(y - yOffset+1, xOffset-2 - x, 1, dial9_11[1]);  // 5
-        u8x8.drawTile(y - yOffset+1, xOffset - x, 1, dial9_5[2]);   // 3
-        break;
+  /* Draw a square N-tile dial at the specified location displaying the value from 0 to 1024.
+  * Only tiles that differ from the state the dial last drew are sent.
+  */
+  template <uint8_t N>
+  void drawDial(int x, int y, U8x8TilesR3Dial<N> &dial, int val) {
+    U8X8TILESR3_API(DIAL);
+    typedef typename U8x8TilesR3Dial<N>::Tiles Tiles;
+    uint8_t state = dial.stateOf(val);
+    if (state == dial.last) return;
+    bool batch = openBatch();
+    for (uint8_t t = 0; t < N; t++) {
+      uint8_t i = Tiles::index(state, t);
+      if (dial.last < Tiles::states && Tiles::index(dial.last, t) == i) continue;
+      putTile(x + t % Tiles::side, y + t / Tiles::side, Tiles::tile(i));
     }
+    dial.last = state;
+    closeBatch(batch);
   }
 
   /* Draw a five-tile (1 x 5) VU metre at the specified tile location */
   void drawVUBar5(int x, int y, int val) {  // val, 0 - 40
-    if (val <= 8) {
-      u8x8.drawTile(y - yOffset + 4, xOffset - x, 1, vuBars[val]);
-      u8x8.drawTile(y - yOffset + 3, xOffset - x, 1, vuBars[0]);
-      u8x8.drawTile(y - yOffset + 2, xOffset - x, 1, vuBars[0]);
-      u8x8.drawTile(y - yOffset + 1, xOffset - x, 1, vuBars[0]);
-      u8x8.drawTile(y - yOffset + 0, xOffset - x, 1, vuBars[0]);
-    } else if (val <= 16) {
-      u8x8.drawTile(y - yOffset + 4, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 3, xOffset - x, 1, vuBars[val - 8]);
-      u8x8.drawTile(y - yOffset + 2, xOffset - x, 1, vuBars[0]);
-      u8x8.drawTile(y - yOffset + 1, xOffset - x, 1, vuBars[0]);
-      u8x8.drawTile(y - yOffset + 0, xOffset - x, 1, vuBars[0]);
-    } else if (val <= 24) {
-      u8x8.drawTile(y - yOffset + 4, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 3, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 2, xOffset - x, 1, vuBars[val - 16]);
-      u8x8.drawTile(y - yOffset + 1, xOffset - x, 1, vuBars[0]);
-      u8x8.drawTile(y - yOffset + 0, xOffset - x, 1, vuBars[0]);
-    } else if (val <= 32) {
-      u8x8.drawTile(y - yOffset + 4, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 3, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 2, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 1, xOffset - x, 1, vuBars[val - 24]);
-      u8x8.drawTile(y - yOffset + 0, xOffset - x, 1, vuBars[0]);
+    U8X8TILESR3_API(VU);
+    uint8_t column[5 * 8];
+    for (uint8_t k = 0; k < 5; k++) {
+      int fill = val - k * 8;
+      U8X8TILESR3_READ_TILE(column + (4-k)*8, U8x8TilesR3Glyphs::vuBars[fill < 0 ? 0 : (fill > 8 ? 8 : fill)]);
+    }
+    sendTiles(x, y, column, 5, true);
+  }
+
+  /* Draw a VU meter at level val, from 0 to 8 per tile, only sending the tiles whose segments changed */
+  void drawVUMeter(U8x8TilesR3VUMeter &meter, int val) {
+    U8X8TILESR3_API(VU);
+    uint8_t oldLevel = meter.level;
+    uint8_t oldPeak = meter.peak;
+    meter.update(val);
+    bool batch = openBatch();
+    for (uint8_t k = 0; k < meter.length; k++) {
+      uint8_t state = meter.tileState(k, meter.level, meter.peak);
+      if (meter.drawn && state == meter.tileState(k, oldLevel, oldPeak)) continue;
+      uint8_t tile[8];
+      U8X8TILESR3_READ_TILE(tile, U8x8TilesR3Glyphs::vuBars[state & 0x0F]);
+      if (state >> 4) tile[8 - (state >> 4)] = 124; // peak marker row
+      sendTile(meter.x, meter.y + meter.length - 1 - k, tile);
+    }
+    meter.drawn = true;
+    closeBatch(batch);
+  }
+
+  /* Update count meters to their levels in vals, sent together as one batch */
+  void drawVUMeters(U8x8TilesR3VUMeter *meters, const int *vals, uint8_t count) {
+    U8X8TILESR3_API(VU);
+    bool batch = openBatch();
+    for (uint8_t i = 0; i < count; i++) drawVUMeter(meters[i], vals[i]);
+    closeBatch(batch);
+  }
+
+  /* Draw a strip chart at its own location, only sending the tiles whose pixels changed.
+  * Each pixel column is compared with the column it showed at the last draw, still held in the ring
+  * while it is not older than the chart is wide, so flat or empty parts of a scrolling chart are not sent again.
+  */
+  void drawChart(U8x8TilesR3ChartWidget &chart) {
+    U8X8TILESR3_API(CHART);
+    uint8_t h = chart.height;
+    uint8_t end = chart.end();
+    uint8_t column[16 * 8]; // one column of tiles, top to bottom
+    bool batch = openBatch();
+    for (uint8_t tx = 0; tx < chart.width; tx++) {
+      uint16_t changed = chart.drawn ? 0 : 0xFFFF; // a bit per tile, the top tile in bit 0
+      memset(column, 0, h * 8);
+      for (uint8_t c = 0; c < 8; c++) {
+        uint8_t p = tx * 8 + c;
+        uint8_t low = 0, high = 0, oldLow = 0, oldHigh = 0;
+        bool shown = p < end && chart.sample(end - p, low, high);
+        if (shown) {
+          uint8_t bit = 0x80 >> c;
+          for (uint8_t row = h * 8 - 1 - high; row <= h * 8 - 1 - low; row++) column[row] |= bit;
+        }
+        if (!chart.drawn) continue;
+        bool wasShown = p < chart.drawnEnd && chart.drawnEnd - p <= chart.drawnCount;
+        if (wasShown && !chart.sample(chart.drawnEnd - p + chart.pushed, oldLow, oldHigh)) {
+          changed = 0xFFFF; // no longer in the ring
+          continue;
+        }
+        for (uint8_t ty = 0; ty < h; ty++) {
+          // the part of each span inside the levels of this tile, or none
+          uint8_t bottom = (h - 1 - ty) * 8, top = bottom + 7;
+          bool in = shown && low <= top && high >= bottom;
+          bool wasIn = wasShown && oldLow <= top && oldHigh >= bottom;
+          if (in != wasIn || (in && ((low > bottom ? low : bottom) != (oldLow > bottom ? oldLow : bottom) ||
+                                     (high < top ? high : top) != (oldHigh < top ? oldHigh : top)))) {
+            changed |= 1u << ty;
+          }
+        }
+      }
+      uint8_t run = 0;
+      for (uint8_t ty = 0; ty <= h; ty++) {
+        if (ty < h && (changed & (1u << ty))) {
+          run++;
+          continue;
+        }
+        if (run) sendTiles(chart.x + tx, chart.y + ty - run, column + (ty - run) * 8, run, true);
+        run = 0;
+      }
+    }
+    chart.drawn = true;
+    chart.drawnEnd = end;
+    chart.drawnCount = chart.count;
+    chart.pushed = 0;
+    closeBatch(batch);
+  }
+
+  /* Show frame of an animation, sending only the tiles that differ from the frame the animator shows.
+  * The changes are read from where the animator is up to, so stepping one frame reads only that
+  * frame's changes, and frames skipped over combine into one draw of each changed tile.
+  * Animations of more than 16 tiles draw nothing.
+  */
+  void drawAnimation(const U8x8TilesR3Animation &animation, U8x8TilesR3Animator &animator, uint8_t frame) {
+    U8X8TILESR3_API(GLYPH);
+    // one bit of changed and one entry of pool per tile
+    if (animation.width * animation.height > 16) return;
+    uint8_t size = animation.width * animation.height;
+    uint8_t pool[16];
+    uint16_t changed = 0;
+    if (frame >= animation.frames) frame %= animation.frames;
+    uint8_t f = animator.frame;
+    uint16_t offset = animator.next;
+    if (!animator.drawn) {
+      // start from the key frame
+      for (uint8_t t = 0; t < size; t++) pool[t] = U8X8TILESR3_READ_BYTE(animation.key + t);
+      changed = 0xFFFF;
+      f = 0;
+      offset = animation.deltaOffset(1 % animation.frames);
+    } else if (frame == f) {
+      return;
+    }
+    while (f != frame) {
+      if (++f == animation.frames) {
+        f = 0;
+        offset = 0;
+      }
+      uint8_t count = U8X8TILESR3_READ_BYTE(animation.deltas + offset++);
+      for (uint8_t i = 0; i < count; i++, offset += 2) {
+        uint8_t t = U8X8TILESR3_READ_BYTE(animation.deltas + offset);
+        pool[t] = U8X8TILESR3_READ_BYTE(animation.deltas + offset + 1);
+        changed |= 1u << t;
+      }
+    }
+    if (f + 1 == animation.frames) offset = 0;
+    bool batch = openBatch();
+    for (uint8_t t = 0; t < size; t++) {
+      if (changed & (1u << t)) {
+        putTile(animator.x + t % animation.width, animator.y + t / animation.width, animation.tiles + pool[t] * 8);
+      }
+    }
+    closeBatch(batch);
+    animator.frame = frame;
+    animator.next = offset;
+    animator.drawn = true;
+  }
+
+  /* Advance an animation by steps frames, e.g. on each clock tick of a sequencer */
+  void stepAnimation(const U8x8TilesR3Animation &animation, U8x8TilesR3Animator &animator, uint8_t steps = 1) {
+    drawAnimation(animation, animator, (animator.frame + steps) % animation.frames);
+  }
+
+  /* Advance an animation by the frames due since its last step at its interval, call this from loop().
+  * Returns true when tiles may have been drawn.
+  */
+  bool updateAnimation(const U8x8TilesR3Animation &animation, U8x8TilesR3Animator &animator) {
+    unsigned long now = micros();
+    if (!animator.drawn) {
+      animator.lastStep = now;
+      drawAnimation(animation, animator, animator.frame);
+      return true;
+    }
+    unsigned long steps = (now - animator.lastStep) / animator.interval;
+    if (steps == 0) return false;
+    animator.lastStep += steps * animator.interval;
+    stepAnimation(animation, animator, steps % animation.frames);
+    return true;
+  }
+
+  /* Move a marquee on by the pixels due since its last step and draw it, call this from loop().
+  * A late call skips pixels to keep the speed. Returns true when the window was drawn.
+  */
+  bool updateMarquee(U8x8TilesR3Marquee &marquee) {
+    unsigned long now = micros();
+    if (!marquee.drawn) {
+      marquee.lastStep = now;
     } else {
-      u8x8.drawTile(y - yOffset + 4, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 3, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 2, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 1, xOffset - x, 1, vuBars[8]);
-      u8x8.drawTile(y - yOffset + 0, xOffset - x, 1, vuBars[val - 32]);
+      unsigned long steps = (now - marquee.lastStep) / marquee.interval;
+      if (steps == 0 || !marquee.scrolls()) return false;
+      marquee.lastStep += steps * marquee.interval;
+      uint32_t period = (uint32_t)(marquee.textTiles() + marquee.gap) * 8;
+      marquee.offset = (marquee.offset + steps) % period;
+    }
+    drawMarquee(marquee);
+    return true;
+  }
+
+  /* Draw a marquee's window at its current offset.
+  * Each window tile is shifted together from the two text tiles under it, so the work per step
+  * depends on the window and not the text. Each row of the window is sent as one group of tiles,
+  * which is a single transfer when rows lie along display pages (ROTATE_0 and ROTATE_180).
+  */
+  void drawMarquee(U8x8TilesR3Marquee &marquee) {
+    U8X8TILESR3_API(WORD);
+    uint16_t tiles = marquee.textTiles();
+    uint16_t period = marquee.scrolls() ? tiles + marquee.gap : 0xFFFF; // still text does not repeat
+    uint8_t shift = marquee.offset & 7;
+    uint8_t line[16 * 8];
+    uint8_t next[8];
+    bool batch = openBatch();
+    for (uint8_t row = 0; row < (marquee.large ? 2 : 1); row++) {
+      uint16_t k = marquee.offset >> 3;
+      marqueeTile(marquee, k, row, next);
+      for (uint8_t t = 0; t < marquee.length; t++) {
+        uint8_t *tile = line + t * 8;
+        memcpy(tile, next, 8);
+        if (++k == period) k = 0;
+        if (!shift) {
+          if (t + 1 < marquee.length) marqueeTile(marquee, k, row, next);
+          continue;
+        }
+        marqueeTile(marquee, k, row, next);
+        for (uint8_t i = 0; i < 8; i++) tile[i] = (tile[i] << shift) | (next[i] >> (8 - shift));
+      }
+      sendTiles(marquee.x, marquee.y + row, line, marquee.length, false);
     }
+    marquee.drawn = true;
+    closeBatch(batch);
+  }
+
+  /* Draw a word of four-tile (2 x 2) uppercase letters at the specified tile location.
+  * length letters are drawn, padded with spaces past the end of the word, digits are skipped.
+  */
+  void drawWord4(int x, int y, const char *word, int length) {
+    drawText(x, y, word, length, false, TEXT_LARGE);
+  }
+
+  void drawWord4(int x, int y, const char *word) {
+    drawWord4(x, y, word, strlen(word));
   }
 
-  /* Draw up to seven four-tile high VU metre at the specified tile location */
-  void drawWord4(int x, int y, String word, int length) { // mode name, length chars pad with spaces, no punctuation
-    char charbuf[length+1];
-    word.toCharArray(charbuf, length+1);
-    for(int i=0; i<length+1; i++) {
-      int charVal = (int)charbuf[x+i];
-      if (charVal>64 && charVal<91) drawLetter4(x+i*2, y, charVal-65); // caps
-      if (charVal>96 && charVal<123) drawLetter4(x+i*2, y, charVal-97); // lower case to caps
-      if (charVal == 32) drawLetter4(x+i*2, y, 26); // space
-    }
+  void drawWord4(int x, int y, const String &word, int length) {
+    drawWord4(x, y, word.c_str(), length);
   }
 
   /* Draw a single-tile centered dash at the specified tile location */
   void drawDash(int x, int y) {
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, symbols[0]);
+    U8X8TILESR3_API(SYMBOL);
+    putTile(x, y, U8x8TilesR3Glyphs::symbols[0]);
   }
 
   /* Draw a single-tile dot at the specified tile location */
   void drawDot(int x, int y) {
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, symbols[1]);
+    U8X8TILESR3_API(SYMBOL);
+    putTile(x, y, U8x8TilesR3Glyphs::symbols[1]);
   }
 
   /* Draw a single-tile blank space at the specified tile location */
   void drawBlank(int x, int y) {
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, symbols[2]);
+    U8X8TILESR3_API(SYMBOL);
+    putTile(x, y, U8x8TilesR3Glyphs::symbols[2]);
   }
 
   /* Draw a single-tile centered negative or minus at the specified tile location */
   void drawNegative(int x, int y) {
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, symbols[3]);
+    U8X8TILESR3_API(SYMBOL);
+    putTile(x, y, U8x8TilesR3Glyphs::symbols[3]);
   }
 
   /* Draw a single-tile dash at val height location the specified tile x y coords */
   void drawHeightMark(int x, int y, int val) { // 0 - 7
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, heightMarks[val]);
+    U8X8TILESR3_API(SYMBOL);
+    putTile(x, y, U8x8TilesR3Glyphs::heightMarks[val]);
   }
 
-  /* Draw a single-tile uppercase letter at the specified tile location */
-  void drawLetter(int x, int y, int n) { 
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, letters[n]);
+  /* Draw a single-tile uppercase letter at the specified tile location, with any overlays */
+  void drawLetter(int x, int y, int n, uint8_t overlays = 0) { 
+    U8X8TILESR3_API(LETTER);
+    putTile(x, y, U8x8TilesR3Glyphs::letters[n], overlays);
   }
 
   /* Draw a single-tile uppercase letter 
   * with a dotted bar on the right 
   * at the specified tile location */
   void drawLetterBar(int x, int y, int n) { 
-    u8x8.drawTile(y-yOffset, xOffset-x, 1, lettersBar[n]);
-  }
-
-  /* Draw a string of length single-tile uppercase letters/numbers/spaces at the specified tile location */
-  void drawWord(int x, int y, String word, int length) { // length chars pad with spaces, no punctuation
-    char charbuf[length+1];
-    word.toCharArray(charbuf, length+1);
-    for(int i=0; i<length; i++) {
-      int charVal = (int)charbuf[i];
-      if (charVal>64 && charVal<91) drawLetter(x+i, y, charVal-65); // caps
-      if (charVal>96 && charVal<123) drawLetter(x+i, y, charVal-97); // lower case to caps
-      if (charVal>=0 && charVal<=9) drawNumber(x+i, y, charVal); // numbers
-      if (charVal == 32) drawLetter(x+i, y, 26); // space
-    }
-  }
-
-  /* Draw a word of single-tile uppercase letters 
-  * with a dotted bar on the right at the specified tile location */
-  void drawWordBar(int x, int y, String word, int length) { // add bar to 3 chars pad with spaces, no punctuation
-    char charbuf[length+1];
-    word.toCharArray(charbuf, length+1);
-    for(int i=0; i<length; i++) {
-      int charVal = (int)charbuf[i];
-      if (i < length-1) {
-        if (charVal>64 && charVal<91) drawLetter(x+i, y, charVal-65); // caps
-        if (charVal>96 && charVal<123) drawLetter(x+i, y, charVal-97); // lower case to caps
-        if (charVal>=48 && charVal<=57) drawNumber(x+i, y, charVal-48); // numbers
-        if (charVal == 32) drawLetter(x+i, y, 26); // space
-      } else { // last char
-        if (charVal>64 && charVal<91) drawLetterBar(x+i, y, charVal-65); // caps
-        if (charVal>96 && charVal<123) drawLetterBar(x+i, y, charVal-97); // lower case to caps
-        if (charVal>=48 && charVal<=57) drawNumber(x+i, y, charVal-48); // numbers
-        if (charVal == 32) drawLetterBar(x+i, y, 26); // space
-      }
+    drawLetter(x, y, n, OVERLAY_BAR);
+  }
+
+  /* Draw a string of length single-tile uppercase letters/numbers/spaces at the specified tile location.
+  * The word is padded with spaces past its end, other characters leave their tile untouched.
+  * Overlays apply to every tile, e.g. OVERLAY_INVERT for a selected menu item.
+  */
+  void drawWord(int x, int y, const char *word, int length, uint8_t overlays = 0) {
+    drawText(x, y, word, length, false, TEXT_PLAIN, overlays);
+  }
+
+  void drawWord(int x, int y, const char *word, Overlay overlays = OVERLAY_NONE) {
+    drawWord(x, y, word, strlen(word), overlays);
+  }
+
+  void drawWord(int x, int y, const String &word, int length, uint8_t overlays = 0) {
+    drawWord(x, y, word.c_str(), length, overlays);
+  }
+
+  /* Draw a word of single-tile uppercase letters
+  * with a dotted bar on the right of the last letter at the specified tile location */
+  void drawWordBar(int x, int y, const char *word, int length) {
+    drawText(x, y, word, length, false, TEXT_BAR);
+  }
+
+  void drawWordBar(int x, int y, const char *word) {
+    drawWordBar(x, y, word, strlen(word));
+  }
+
+  void drawWordBar(int x, int y, const String &word, int length) {
+    drawWordBar(x, y, word.c_str(), length);
+  }
+
+#if defined(ARDUINO)
+  /* Versions of the word functions for F("...") strings kept in flash */
+  void drawWord(int x, int y, const __FlashStringHelper *word, int length, uint8_t overlays = 0) {
+    drawText(x, y, (const char *)word, length, true, TEXT_PLAIN, overlays);
+  }
+
+  void drawWordBar(int x, int y, const __FlashStringHelper *word, int length) {
+    drawText(x, y, (const char *)word, length, true, TEXT_BAR);
+  }
+
+  void drawWord4(int x, int y, const __FlashStringHelper *word, int length) {
+    drawText(x, y, (const char *)word, length, true, TEXT_LARGE);
+  }
+
+  void drawWord(int x, int y, const __FlashStringHelper *word, Overlay overlays = OVERLAY_NONE) {
+    drawWord(x, y, word, strlen_P((const char *)word), overlays);
+  }
+
+  void drawWordBar(int x, int y, const __FlashStringHelper *word) {
+    drawWordBar(x, y, word, strlen_P((const char *)word));
+  }
+
+  void drawWord4(int x, int y, const __FlashStringHelper *word) {
+    drawWord4(x, y, word, strlen_P((const char *)word));
+  }
+#endif
+
+  /* Draw a number W single tiles wide, right-aligned, at the specified tile location.
+  * @value is a fixed-point number with the decimal places given by @format,
+  * plus U8x8TilesR3Number::SCALE to shorten large values with a K or M suffix.
+  * Only the tiles that differ from what the field last drew are sent.
+  */
+  template <uint8_t W>
+  void drawNumberField(int x, int y, U8x8TilesR3NumberField<W> &field, long value, uint8_t format = 0) {
+    drawNumberCodes(x, y, field.last, W, value, format);
+  }
+
+  /* Draw a number up to 16 single tiles wide at the specified tile location, sending every tile */
+  void drawNumberField(int x, int y, long value, uint8_t width, uint8_t format = 0) {
+    U8X8TILESR3_API(FIELD);
+    uint8_t codes[16];
+    if (width > 16) width = 16;
+    U8x8TilesR3Number::render(codes, width, value, format);
+    bool batch = openBatch();
+    for (uint8_t i = 0; i < width; i++) putNumberCode(x + i, y, codes[i]);
+    closeBatch(batch);
+  }
+
+  /* Draw character c of a generated font with its top left tile at the specified location.
+  * Characters the font does not have are left undrawn.
+  */
+  void drawChar(int x, int y, const U8x8TilesR3Font &font, char c) {
+    U8X8TILESR3_API(FONT);
+    uint8_t g = (uint8_t)c - font.first;
+    if (g >= font.count) return;
+    bool batch = openBatch();
+    uint8_t tile[8];
+    for (uint8_t t = 0; t < font.width * font.height; t++) {
+      font.readTile(tile, g, t);
+      sendTile(x + t % font.width, y + t / font.width, tile);
     }
+    closeBatch(batch);
+  }
+
+  /* Draw a string in a generated font, one glyph width apart */
+  void drawString(int x, int y, const U8x8TilesR3Font &font, const char *str) {
+    U8X8TILESR3_API(FONT);
+    bool batch = openBatch();
+    for (; *str; str++, x += font.width) drawChar(x, y, font, *str);
+    closeBatch(batch);
   }
 
-  /* Draw a 3-digit single-tile number (-99 to 100) at the specified tile location 
-  * @val is the number, -100 to 100, to be displayed
-  * If the number is negative, -1 to -99, a dash is displayed in the first tile
+  /* Draw a 3-digit single-tile number (-99 to 999) at the specified tile location 
+  * @val is the number to be displayed
+  * If the number is negative a dash is displayed before its digits
   */
   void draw100(int x, int y, int val) {
-    // int n = max(-99.0f, min(100.0f, val * 0.098f));
-    int n = val;
-    if (n >= 100) {
-      drawNumber(x, y, floor(n/100));
-      drawNumber(x+1, y, floor((int)(n/10) % 10));
-      drawNumber(x+2, y, floor((int)n % 10));
-    } else if (n > 9) {
-      drawBlank(x, y);
-      drawNumber(x+1, y, floor(n/10));
-      drawNumber(x+2, y, n%10);
-    } else if (n >= 0) {
-      drawBlank(x, y);
-      drawBlank(x+1, y);
-      drawNumber(x+2, y, n);
-    } else if (n >= -10) {
-      drawBlank(x, y);
-      drawNegative(x+1, y);
-      drawNumber(x+2, y, abs(n));
-    } else if (n >= -100) {
-      drawNegative(x, y);
-      drawNumber(x+1, y, floor((int)(abs(n)/10) % 10));
-      drawNumber(x+2, y, abs(n)%10);
-    } 
+    drawNumberField(x, y, val, 3);
   }
 
   /* Draw a 3-digit single-tile number (.00 to .99) at the specified tile location 
   * @val is the number from 0.00 - 0.99, to be displayed as a 2-decimal number
   */
   void draw1(int x, int y, float val) {
-    drawDot(x, y);
-    drawNumber(x+1, y, floor(val * 10));
-    drawNumber(x+2, y, floor((int)(val * 100) % 10));
+    drawNumberField(x, y, (long)(val * 100), 3, 2);
   }
 
   /* Draw a 3-digit single-tile number (1.0 to 9.9) at the specified tile location 
   * @val is the number from 1.0 - 9.9, to be displayed as a 1-decimal number
   */
   void draw10(int x, int y, float val) {
-    drawNumber(x, y, floor(val));
-    drawDot(x+1, y);
-    drawNumber(x+2, y, floor((int)(val * 10) % 10));
+    drawNumberField(x, y, (long)(val * 10), 3, 1);
   }
 
   /* Draw a 3-digit single-tile number >= 1000 at the specified tile location 
-  * @val is the number from 1000-99999, to be displayed as a 3-digit number in the format 1K
+  * @val is the number from 1000 upwards, to be displayed as a 3-digit number in the format 1K or .1M
   */
-  void draw1000(int x, int y, int val) {
-    if (val >= 1000 && val < 10000) {
-      drawBlank(x, y);
-      drawNumber(x+1, y, floor(val/1000));
-      drawLetter(x+2, y, 10); // K
-    } else {
-      drawNumber(x, y, floor(val/10000));
-      drawNumber(x+1, y, floor((int)(val/1000) % 10));
-      drawLetter(x+2, y, 10); // K
+  void draw1000(int x, int y, long val) {
+    drawNumberField(x, y, val, 3, U8x8TilesR3Number::SCALE);
+  }
+
+  /* Fill a region of width x height tiles with one 8-byte tile pattern in glyph rows, in PROGMEM like the glyphs.
+  * Each line of the region along a display page is sent as the pattern repeated by the controller,
+  * one transfer per line with no tile data buffered. With a shadow, only the runs of tiles not already
+  * holding the pattern are sent.
+  * The fill is sent at once, also in asynchronous mode, replacing any tiles queued inside the region.
+  */
+  void fillRegion(int x, int y, uint8_t width, uint8_t height, const uint8_t *pattern) {
+    U8X8TILESR3_API(FILL);
+    uint8_t rows[8], tile[8];
+    U8X8TILESR3_READ_TILE(rows, pattern);
+    memcpy(tile, rows, 8);
+    bool down = !landscape;
+    uint8_t lines = down ? width : height;
+    uint8_t length = down ? height : width;
+    if (landscape) transposeTile(tile);
+    for (uint8_t a = 0; a < lines; a++) {
+      uint8_t run = 0;
+      for (uint8_t b = 0; b <= length; b++) {
+        bool changed = b < length && tileChanged(down ? x+a : x+b, down ? y+b : y+a, rows);
+#if U8X8TILESR3_STATS
+        if (b < length && !changed) apiCounters().skipped++;
+#endif
+        if (changed) {
+          run++;
+          continue;
+        }
+        if (run) {
+          int tx = down ? x+a : x+b-run;
+          int ty = down ? y+b-run : y+a;
+          fillTiles(deviceCol(tx, ty), devicePage(tx, ty), run, tile);
+        }
+        run = 0;
+      }
     }
   }
 
+  /* Blank a region of width x height tiles, one transfer per line along a display page */
+  void clearRegion(int x, int y, uint8_t width, uint8_t height) {
+    fillRegion(x, y, width, height, U8x8TilesR3Glyphs::symbols[2]);
+  }
+
+  /* Blank the whole display set by setRotation(), one transfer per page, and record it in the shadow */
+  void clearAll() {
+    if (landscape) clearRegion(0, 0, 16, pageCount);
+    else clearRegion(0, 0, xOffset + 1, 16);
+  }
+
+  enum Rotation : uint8_t { ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270 };
+
+  /* Specify how the display is mounted, clockwise from the controller's own orientation,
+  * and its height in 8-pixel pages (16 for 128 x 128, 8 for 128 x 64).
+  * ROTATE_90, the default, has the top connecting pins on the right.
+  * 180 and 270 use the controller's flip mode so they cost nothing per tile,
+  * 0 and 180 send each glyph transposed.
+  */
+  void setRotation(uint8_t rotation, uint8_t pages = 16) {
+    landscape = !(rotation & 1);
+    if (!landscape) xOffset = pages - 1;
+    pageCount = pages;
+    u8x8.setFlipMode(rotation >= ROTATE_180);
+    invalidate();
+  }
+
   /* Specify the xOffset value for the target screen size */
   void setXOffset(int val) {
     xOffset = val;
@@ -424,80 +1485,772 @@ public:
     yOffset = val;
   }
 
+  /* Forget what the shadow holds so the next draw of every tile is sent,
+  * e.g. after clearing the display directly with u8x8.clear()
+  */
+  void invalidate() {
+#if U8X8TILESR3_SHADOW != U8X8TILESR3_SHADOW_NONE
+    memset(shadowKnown, 0, sizeof(shadowKnown));
+#endif
+  }
+
+  /* Queue tile writes until flush() instead of sending each one as it is drawn */
+  void beginBatch() {
+#if U8X8TILESR3_BATCH_SIZE > 0
+    batching = true;
+#endif
+  }
+
+  /* Send the queued tiles and end the batch.
+  * Tiles are sorted by display page and each run of adjacent tiles goes out in one drawTile call.
+  */
+  void flush() {
+    U8X8TILESR3_API(SEND);
+#if U8X8TILESR3_BATCH_SIZE > 0
+    sendBatch();
+    batching = false;
+#endif
+  }
+
+  /* In asynchronous mode draw calls only queue their changed tiles and service() sends them,
+  * so drawing does not wait for the bus while the queue has room. A tile drawn again before it is
+  * sent replaces the queued one. When the queue is full, the next new tile first sends one run to
+  * make room, so that draw waits for the bus. To keep drawing from waiting, make U8X8TILESR3_BATCH_SIZE
+  * at least the number of different tiles drawn between service() calls.
+  */
+  void setAsync(bool on) {
+#if U8X8TILESR3_BATCH_SIZE > 0
+    async = on;
+    if (!on) flush();
+#else
+    (void)on;
+#endif
+  }
+
+  /* Send queued tiles for up to budget microseconds, call this from loop() in asynchronous mode.
+  * Runs of adjacent tiles are sent in page order while the estimated time of the next run fits,
+  * and at least one run is sent per call. Returns the number of tiles still queued.
+  */
+  uint8_t service(unsigned long budget) {
+    U8X8TILESR3_API(SEND);
+#if U8X8TILESR3_BATCH_SIZE > 0
+    unsigned long start = micros();
+    sortBatch();
+    bool sent = false;
+    while (batchCount) {
+      unsigned long runStart = micros();
+      if (sent && runStart - start + (unsigned long)tileMicros * runLength() > budget) break;
+      sent = true;
+      uint8_t n = sendRun();
+      // running average of the bus time per tile, used to fit runs into the budget
+      uint16_t perTile = (micros() - runStart) / n;
+      tileMicros = tileMicros ? (tileMicros * 3 + perTile) / 4 : perTile;
+    }
+    return batchCount;
+#else
+    (void)budget;
+    return 0;
+#endif
+  }
+
+  /* Number of tiles waiting to be sent */
+  uint8_t pending() const {
+#if U8X8TILESR3_BATCH_SIZE > 0
+    return batchCount;
+#else
+    return 0;
+#endif
+  }
+
+#if U8X8TILESR3_STATS
+  /* Counters since the last resetStats() */
+  const U8x8TilesR3Stats &stats() const {
+    return counters;
+  }
+
+  void resetStats() {
+    counters.reset();
+  }
+
+  /* Count a frame, for the per-frame averages */
+  void endFrame() {
+    counters.frames++;
+  }
+
+  template <class Out> void printStats(Out &out) const {
+    counters.print(out);
+  }
+#endif
+
  private:
-  uint8_t oledBarRotate = 0;
+  template <class> friend class U8x8TilesR3Screen;
+
+#if U8X8TILESR3_STATS
+  U8x8TilesR3Stats counters;
+  uint8_t currentApi = U8x8TilesR3Stats::COUNT; // outermost draw call in progress, COUNT when none
+
+  /* Marks the outermost draw call, whose group the tiles sent until it returns are counted against */
+  class ApiScope {
+  public:
+    ApiScope(U8x8TilesR3Panel *panel, uint8_t api) : panel(panel), outer(panel->currentApi == U8x8TilesR3Stats::COUNT) {
+      if (!outer) return;
+      panel->currentApi = api;
+      panel->counters.api[api].calls++;
+    }
+    ~ApiScope() {
+      if (outer) panel->currentApi = U8x8TilesR3Stats::COUNT;
+    }
+  private:
+    U8x8TilesR3Panel *panel;
+    bool outer;
+  };
+
+  U8x8TilesR3Stats::Counters &apiCounters() {
+    return counters.api[currentApi < U8x8TilesR3Stats::COUNT ? currentApi : (uint8_t)U8x8TilesR3Stats::OTHER];
+  }
+#endif
+
+  enum TextStyle : uint8_t { TEXT_PLAIN, TEXT_BAR, TEXT_LARGE };
+
+  Display &u8x8;
+
+  bool landscape = false; // glyphs are stored for the rotated (portrait) mounting
+  uint8_t pageCount = 16;
   // Functions designed for a 128 x 128 display has 16 x 16 tiles of 8 x 8 pixels
   // x axis, y on rotation: -12 to 3 tile positions (odd?)
   // y axis, x on rotation: 15 to 0 tile positions
   uint8_t xOffset = 15; // negative
   uint8_t yOffset = 12;
-  // 0,0 is top left corner
-  uint8_t circle4[4][8] = { { 0, 7, 24, 32, 32, 64, 64, 64 }, {  0, 224, 24, 4, 4, 2, 2, 2 }, { 64, 64, 64, 32, 32, 24, 7, 0 }, {2, 2, 2, 4, 4, 24, 224, 0 }};
-  uint8_t circle4_1[4][8] = { { 0, 7, 24, 34, 36, 72, 72, 72 }, { 0, 224, 24, 196, 36, 18, 18, 18 }, { 72, 72, 72, 36, 35, 24, 7, 0 }, {18, 18, 18, 36, 196, 24, 224, 0 }};
-  uint8_t circle4_2[4][8] = { { 0, 7, 24, 35, 36, 73, 74, 74 }, { 0, 224, 24, 196, 36, 146, 82, 82 }, { 74, 74, 73, 36, 35, 24, 7, 0 }, {82, 82, 146, 36, 196, 24, 224, 0 }};
-  uint8_t circle4_3[4][8] = { { 0, 7, 31, 63, 63, 127, 127, 127 }, { 0, 224, 248, 252, 252, 254, 254, 254 }, { 127, 127, 127, 63, 63, 31, 7, 0 }, {254, 254, 254, 252, 252, 248, 224, 0 }}; 
-  uint8_t circle9[9][8] = { { 0, 0, 7, 4, 8, 16, 32, 32 }, { 0, 126, 129, 0, 0, 0, 0, 0 }, { 0, 0, 224, 32, 16, 8, 4, 4 }, { 32, 64, 64, 64, 64, 64, 64, 32 }, { 0, 0, 0, 24, 24, 16, 16, 16 }, { 4, 2, 2, 2, 2, 2, 2, 4 }, { 32, 32, 16, 8, 4, 3, 0, 0 }, { 16, 16, 16, 16, 16, 129, 126, 0 }, { 4, 4, 8, 16, 32, 192, 0, 0 } };
-  uint8_t dial9_1[2][8] = { { 0, 0, 0, 24, 24, 16, 48, 48 }, { 112, 112, 112, 240, 240, 240, 126, 0 } };                                                                                   // 4, 7
-  uint8_t dial9_2[4][8] = { { 32, 64, 64, 64, 64, 64, 64, 35 }, { 0, 0, 0, 24, 24, 48, 112, 240 }, { 63, 63, 31, 15, 7, 3, 0, 0 }, { 240, 240, 240, 240, 240, 241, 126, 0 } };             //3, 4, 6, 7
-  uint8_t dial9_3[2][8] = { { 32, 64, 64, 64, 127, 127, 127, 63 }, { 0, 0, 0, 24, 248, 240, 240, 240 } };                                                                                  //3, 4
-  uint8_t dial9_4[2][8] = { { 56, 127, 127, 127, 127, 127, 127, 63 }, { 0, 0, 192, 248, 248, 240, 240, 240 } };                                                                            // 3, 4
-  uint8_t dial9_5[4][8] = { { 0, 0, 3, 7, 15, 31, 63, 63 }, { 0, 126, 129, 0, 0, 128, 128, 128 }, { 63, 127, 127, 127, 127, 127, 127, 63 }, { 192, 192, 224, 248, 248, 240, 240, 240 } };  //0, 1, 3, 4
-  uint8_t dial9_6[2][8] = { { 0, 126, 241, 240, 240, 240, 240, 240 }, { 240, 240, 240, 248, 248, 240, 240, 240 } };                                                                        // 1, 4
-  uint8_t dial9_7[3][8] = { { 0, 126, 255, 255, 255, 255, 255, 255 }, { 0, 0, 224, 160, 144, 8, 4, 4 }, { 254, 252, 252, 248, 248, 240, 240, 240 } };                                      // 1, 2, 4
-  uint8_t dial9_8[3][8] = { { 0, 0, 192, 224, 240, 248, 252, 252 }, { 255, 255, 255, 252, 248, 240, 240, 240 }, { 244, 194, 2, 2, 2, 2, 2, 4 } };                                          //2, 4, 5
-  uint8_t dial9_9[2][8] = { { 255, 255, 255, 255, 248, 240, 240, 240 }, { 252, 254, 254, 254, 2, 2, 2, 4 } };
-  uint8_t dial9_10[3][8] = { { 255, 255, 255, 255, 255, 243, 240, 240 }, { 252, 254, 254, 254, 254, 254, 254, 60 }, { 12, 4, 8, 16, 32, 192, 0, 0 } };                                                //4, 5, 8
-  uint8_t dial9_11[4][8] = { { 255, 255, 255, 255, 255, 247, 243, 241 }, { 252, 254, 254, 254, 254, 254, 254, 252 }, { 241, 240, 240, 240, 240, 241, 126 }, { 252, 252, 248, 112, 96, 192, 0, 0 } };  //4, 5, 7, 8
-  uint8_t dial9_12[3][8] = { { 255, 255, 255, 255, 255, 255, 255, 255 }, { 255, 255, 255, 255, 255, 255, 126, 0 }, {252, 252, 248, 240, 224, 192, 0, 0} };                                                                                  //4, 7, 8
-  uint8_t vuBars[9][8] = { {0, 16, 0, 16, 0, 16, 0, 16}, {0, 16, 0, 16, 0, 16, 0, 124}, {0, 16, 0, 16, 0, 16, 124, 124}, {0, 16, 0, 16, 0, 124, 124, 124 }, {0, 16, 0, 16, 124, 124, 124, 124}, {0, 16, 0, 124, 124, 124, 124, 124}, {0, 16, 124, 124, 124, 124, 124, 124}, {0, 124, 124, 124, 124, 124, 124, 124 }, { 124, 124, 124, 124, 124, 124, 124, 124 } };
-  uint8_t letters4[27][4][8] = {{{0,3,7,28,56,56,112,127}, {0,192,224,56,28,28,14,254}, {127,96,96,96,96,96,96,96}, {254,6,6,6,6,6,6,6}}, // A
-    {{0,127,127,96,96,96,96,127}, {0,248,252,12,6,6,12,252}, {127,96,96,96,96,96,127,127}, {248,12,6,6,6,12,252,248}}, // B
-    {{0,15,31,56,112,96,96,96}, {0,248,252,14,6,6,0,0}, {96,96,96,96,112,56,31,15}, {0,0,0,6,6,14,252,248}}, // C
-    {{0,127,127,96,96,96,96,96},{0,248,252,12,6,6,6,6}, {96,96,96,96,96,96,127,127}, {6,6,6,6,6,12,252,248}}, // D
-    {{0,127,127,96,96,96,96,127}, {0,254,254,0,0,0,0,248}, {127,96,96,96,96,96,127,127}, {248,0,0,0,0,0,254,254}}, // E
-    {{0,127,127,96,96,96,96,127}, {0,254,254,0,0,0,0,248}, {127,96,96,96,96,96,96,96}, {248,0,0,0,0,0,0,0}}, // F
-    {{0,31,63,112,96,96,96,96}, {0,254,254,0,0,0,0,124}, {96,96,96,96,96,112,63,31}, {126,6,6,6,6,14,254,252}}, // G
-    {{0,96,96,96,96,96,96,127}, {0,6,6,6,6,6,6,254}, {127,96,96,96,96,96,96,96}, {254,6,6,6,6,6,6,6}}, // H
-    {{0,31,31,1,1,1,1,1}, {0,248,248,128,128,128,128,128}, {1,1,1,1,1,1,31,31}, {128,128,128,128,128,128,248,248}}, // I
-    {{0,0,0,0,0,0,0,0}, {0,62,62,6,6,6,6,6}, {0,0,0,96,96,112,63,31}, {6,6,6,6,6,12,252,248}}, // J
-    {{0,96,96,96,97,103,126,120}, {0,6,30,120,224,128,0,0}, {120,124,102,103,97,96,96,96}, {0,0,0,128,224,120,30,6}}, // K
-    {{0,96,96,96,96,96,96,96}, {0,0,0,0,0,0,0,0}, {96,96,96,96,96,96,127,127}, {0,0,0,0,0,0,254,254}}, // L
-    {{0,96,120,126,103,97,97,97}, {0,6,30,126,230,134,134,134}, {96,96,96,96,96,96,96,96}, {6,6,6,6,6,6,6,6}}, // M
-    {{0,96,96,96,120,126,103,97}, {0,6,6,6,6,6,134,230}, {96,96,96,96,96,96,96,96},{126,30,6,6,6,6,6,6}}, // N
-    {{0,31,63,112,96,96,96,96}, {0,252,254,14,6,6,6,6}, {96,96,96,96,96,112,63,31}, {6,6,6,6,6,14,254,252}}, // O
-    {{0,127,127,96,96,96,96,127}, {0,252,254,14,6,6,14,252}, {127,96,96,96,96,96,96,96}, {248,0,0,0,0,0,0,0}}, // P
-    {{0,31,63,112,96,96,96,96}, {0,252,254,14,6,6,6,6}, {96,96,96,96,96,112,63,31}, {6,198,230,118,62,30,254,252}}, // Q
-    {{0,127,127,96,96,96,96,127}, {0,248,252,12,6,6,12,252}, {127,124,111,99,96,96,96,96}, {248,0,0,192,240,60,14,6}}, // R
-    {{0,31,63,112,96,96,96,63}, {0,248,252,14,6,0,0,252}, {31,0,0,0,96,112,63,31}, {254,14,6,6,6,14,252,248}}, // S
-    {{0,127,127,1,1,1,1,1}, {0,254,254,128,128,128,128,128}, {1,1,1,1,1,1,1,1}, {128,128,128,128,128,128,128,128}}, // T
-    {{0,96,96,96,96,96,96,96}, {0,6,6,6,6,6,6,6}, {96,96,96,96,96,112,63,31}, {6,6,6,6,6,14,254,252}}, // U
-    {{0,96,96,96,96,96,96,96}, {0,6,6,6,6,6,6,6}, {96,96,96,112,56,30,7,1}, {6,6,6,14,28,120,224,128}}, // V
-    {{0,96,96,96,96,96,96,96}, {0,6,6,6,6,6,6,6}, {96,96,97,97,103,126,120,96}, {6,6,134,134,230,126,30,6}}, // W
-    {{0,96,96,96,96,120,30,7}, {0,6,6,6,6,30,120,224}, {1,7,30,120,96,96,96,96}, {224,248,30,6,6,6,6,6}}, //X
-    {{0,96,96,96,96,120,30,7}, {0,6,6,6,6,30,120,224}, {1,1,1,1,1,1,1,1}, {128,128,128,128,128,128,128,128}}, // Y
-    {{0,127,127,0,0,0,0,1}, {0,254,254,6,6,30,120,224}, {7,30,120,96,96,96,127,127}, {128,0,0,0,0,0,254,254}}, // Z
-    {{0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}}}; // space
-  uint8_t symbols[4][8] = {{0, 0, 0, 0, 255, 0, 0, 0}, {0, 0, 0, 24, 24, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 126, 0, 0, 0}};// dash, dot, blank, negative
-  uint8_t heightMarks[8][8] = {{0,0,0,0,0,0,0,126}, {0,0,0,0,0,0,126,0}, {0,0,0,0,0,126,0,0}, {0,0,0,0,126,0,0,0}, 
-    {0,0,0,126,0,0,0,0}, {0,0,126,0,0,0,0,0}, {0,126,0,0,0,0,0,0}, {126,0,0,0,0,0,0,0}}; // hight marks
-  uint8_t numbers[10][8] = {{0, 56, 68, 68, 68, 68, 56, 0}, {0, 48, 80, 16, 16, 16, 124, 0},
-    {0, 56, 68, 8, 16, 32, 124}, {0, 56, 68, 4, 24, 68, 56, 0}, {0, 8, 24, 40, 72, 124, 8, 0},
-    {0, 124, 64, 56, 4, 68, 56, 0}, {0, 56, 64, 120, 68, 68, 56, 0}, {0, 124, 4, 8, 16, 32, 64, 0},
-    {0, 56, 68, 56, 68, 68, 56, 0}, {0, 56, 68, 68, 60, 4, 56, 0}}; // numbers
-  uint8_t letters[27][8] = {{0,56,68,68,124,68,68,0}, {0,120,68,68,120,68,124,0}, {0,56,68,64,64,68,56,0}, {0,120,68,68,68,68,120,0}, // A,B,C,D
-    {0,124,64,64,120,64,124,0}, {0,124,64,64,120,64,64,0}, {0,56,68,64,92,68,56,0}, {0,68,68,68,124,68,68,0}, // E,F,G,H
-    {0,124,16,16,16,16,124,0}, {0,4,4,4,4,68,56,0}, {0,68,72,112,112,72,68,0}, {0,64,64,64,64,64,124,0}, //I,J,K,L
-    {0,68,108,84,68,68,68,0}, {0,68,100,84,76,68,68,0}, {0,56,68,68,68,68,56,0}, {0,120,68,68,120,64,64,0}, //M,N,O,P
-    {0,56,68,68,84,76,60,0}, {0,120,68,68,120,72,68,0}, {0,56,68,32,24,68,56,0}, {0,124,16,16,16,16,16,0}, //Q,R,S,T
-    {0,68,68,68,68,68,56,0}, {0,68,68,68,68,40,16,0}, {0,68,68,84,84,84,40,0}, {0,68,68,40,16,40,68,0}, //U,V,W,  
-    {0,68,68,40,16,16,16,0}, {0,124,4,8,16,32,124,0}, {0,0,0,0,0,0,0,0}}; //Y,Z,space
-  uint8_t lettersBar[27][8] = {{0,57,68,69,124,69,68,1}, {0,121,68,69,120,69,120,1}, {0,57,68,65,64,69,56,1}, {0,121,68,69,68,69,120,1}, // A,B,C,D
-    {0,125,64,65,120,65,124,1}, {0,125,64,65,120,65,64,1}, {0,57,68,65,92,69,56,1}, {0,69,68,69,124,69,68,1}, // E,F,G,H
-    {0,125,16,17,16,17,124,1}, {0,5,4,5,4,69,56,1}, {0,69,72,81,96,73,68,1}, {0,65,64,65,64,65,124,1}, //I,J,K,L
-    {0,69,108,85,68,69,68,1}, {0,69,100,85,76,69,68,1}, {0,57,68,69,68,69,56,1}, {0,121,68,69,120,65,64,1}, //M,N,O,P
-    {0,57,68,69,84,77,60,1}, {0,121,68,69,120,73,68,1}, {0,57,68,33,24,69,56,1}, {0,125,16,17,16,17,16,1}, //Q,R,S,T
-    {0,69,68,69,68,69,56,1}, {0,69,68,69,68,41,16,1}, {0,69,68,85,84,85,40,1}, {0,69,68,41,16,41,68,1}, //U,V,W,X
-    {0,69,68,41,16,17,16,1}, {0,125,4,9,16,33,124,1}, {0,1,0,1,0,1,0,1}}; //Y,Z,space
+
+#if U8X8TILESR3_SHADOW != U8X8TILESR3_SHADOW_NONE
+  // one bit per tile, set once the shadow matches what is on the panel
+  uint8_t shadowKnown[32] = {0};
+#endif
+#if U8X8TILESR3_SHADOW == U8X8TILESR3_SHADOW_HASH
+  uint16_t shadowHash[256];
+#elif U8X8TILESR3_SHADOW == U8X8TILESR3_SHADOW_FULL
+  uint8_t shadowTiles[256][8];
+#endif
+#if U8X8TILESR3_BATCH_SIZE > 0
+  // queued tiles in display coordinates, kept as parallel arrays so a sorted run is contiguous
+  bool batching = false;
+  bool async = false;
+  uint16_t tileMicros = 0; // measured bus time per tile
+  uint8_t batchCount = 0;
+  static_assert(U8X8TILESR3_BATCH_SIZE >= 2 && U8X8TILESR3_BATCH_SIZE <= 255, "a batch holds 2 to 255 tiles");
+  uint8_t batchCol[U8X8TILESR3_BATCH_SIZE];
+  uint8_t batchPage[U8X8TILESR3_BATCH_SIZE];
+  uint8_t batchTiles[U8X8TILESR3_BATCH_SIZE][8];
+#if U8X8TILESR3_STATS
+  uint8_t batchApi[U8X8TILESR3_BATCH_SIZE]; // draw call group that queued each tile
+#endif
+#endif
+
+  /* Draw length characters of a word held in RAM or, when flash is set, in PROGMEM.
+  * Characters are decoded with the ascii table and the word is padded with spaces past its end.
+  * TEXT_BAR adds the bar overlay to the last letter.
+  */
+  void drawText(int x, int y, const char *word, int length, bool flash, TextStyle style, uint8_t overlays = 0) {
+#if U8X8TILESR3_STATS
+    ApiScope apiScope(this, style == TEXT_LARGE ? U8x8TilesR3Stats::LARGE : U8x8TilesR3Stats::WORD);
+#endif
+    bool batch = openBatch();
+    bool ended = false;
+    for (int i = 0; i < length; i++) {
+      uint8_t c = ' ';
+      if (!ended) {
+        c = flash ? U8X8TILESR3_READ_BYTE(word + i) : (uint8_t)word[i];
+        if (c == 0) {
+          ended = true;
+          c = ' ';
+        }
+      }
+      uint8_t glyph = c < 128 ? U8X8TILESR3_READ_BYTE(&U8x8TilesR3Glyphs::ascii[c]) : 0xFF;
+      if (glyph == 0xFF) continue;
+      if (style == TEXT_LARGE) {
+        if (!(glyph & 0x80)) drawLetter4(x+i*2, y, glyph);
+      } else if (glyph & 0x80) {
+        drawNumber(x+i, y, glyph & 0x0F, overlays);
+      } else if (style == TEXT_BAR && i == length-1) {
+        drawLetter(x+i, y, glyph, overlays | OVERLAY_BAR);
+      } else {
+        drawLetter(x+i, y, glyph, overlays);
+      }
+    }
+    closeBatch(batch);
+  }
+
+  /* Draw a number width tiles wide (up to 16), skipping tiles whose code matches last, then update last */
+  void drawNumberCodes(int x, int y, uint8_t *last, uint8_t width, long value, uint8_t format) {
+    U8X8TILESR3_API(FIELD);
+    uint8_t codes[16];
+    U8x8TilesR3Number::render(codes, width, value, format);
+    bool batch = openBatch();
+    for (uint8_t i = 0; i < width; i++) {
+      if (codes[i] == last[i]) continue;
+      putNumberCode(x + i, y, codes[i]);
+      last[i] = codes[i];
+    }
+    closeBatch(batch);
+  }
+
+  /* Copy row of tile k of a marquee's text, blank past its end or for characters without a glyph */
+  void marqueeTile(const U8x8TilesR3Marquee &marquee, uint16_t k, uint8_t row, uint8_t *tile) {
+    uint16_t i = marquee.large ? k >> 1 : k;
+    uint8_t c = i >= marquee.textLength ? ' '
+              : (marquee.inFlash ? U8X8TILESR3_READ_BYTE(marquee.text + i) : (uint8_t)marquee.text[i]);
+    uint8_t glyph = c < 128 ? U8X8TILESR3_READ_BYTE(&U8x8TilesR3Glyphs::ascii[c]) : 0xFF;
+    if (glyph == 0xFF || (marquee.large && (glyph & 0x80))) {
+      memset(tile, 0, 8);
+    } else if (marquee.large) {
+      U8X8TILESR3_READ_TILE(tile, U8x8TilesR3Glyphs::letters4[glyph][row * 2 + (k & 1)]);
+    } else {
+      U8X8TILESR3_READ_TILE(tile, glyph & 0x80 ? U8x8TilesR3Glyphs::numbers[glyph & 0x0F] : U8x8TilesR3Glyphs::letters[glyph]);
+    }
+  }
+
+  /* drawGlyph() for a table held by pointer, which must hold at least W x H tiles */
+  template <uint8_t W, uint8_t H>
+  void drawGlyphTiles(int x, int y, const uint8_t (*tiles)[8], bool transparent = false) {
+    U8X8TILESR3_API(GLYPH);
+    // scan the glyph along display pages: by column when the panel is portrait, by row when landscape
+    bool down = !landscape;
+    uint8_t lines = down ? W : H;
+    uint8_t length = down ? H : W;
+    uint8_t line[(W > H ? W : H) * 8];
+    for (uint8_t a = 0; a < lines; a++) {
+      uint8_t n = 0;
+      for (uint8_t b = 0; b <= length; b++) {
+        uint8_t *tile = line + n*8;
+        if (b < length) {
+          U8X8TILESR3_READ_TILE(tile, tiles[down ? b*W + a : a*W + b]);
+          if (!transparent || !isBlank(tile)) {
+            n++;
+            continue;
+          }
+        }
+        if (n) {
+          if (down) sendTiles(x+a, y+b-n, line, n, true);
+          else sendTiles(x+b-n, y+a, line, n, false);
+        }
+        n = 0;
+      }
+    }
+  }
+
+  /* Draw the tile for a digit or U8x8TilesR3Number code */
+  void putNumberCode(int x, int y, uint8_t code) {
+    switch (code) {
+      case U8x8TilesR3Number::BLANK: drawBlank(x, y); break;
+      case U8x8TilesR3Number::DOT: drawDot(x, y); break;
+      case U8x8TilesR3Number::NEGATIVE: drawNegative(x, y); break;
+      case U8x8TilesR3Number::KILO: drawLetter(x, y, 10); break; // K
+      case U8x8TilesR3Number::MEGA: drawLetter(x, y, 12); break; // M
+      case U8x8TilesR3Number::TOO_WIDE: drawDash(x, y); break;
+      default: drawNumber(x, y, code);
+    }
+  }
+
+  /* Copy a glyph tile out of the shared tables and draw it at the specified tile location */
+  void putTile(int x, int y, const uint8_t *glyph, uint8_t overlays = 0) {
+    uint8_t tile[8];
+    U8X8TILESR3_READ_TILE(tile, glyph);
+    if (overlays) overlayTile(tile, overlays);
+    sendTile(x, y, tile);
+  }
+
+  /* Combine overlays with a tile in place, 4 rows at a time: AND, then OR, then XOR */
+  static void overlayTile(uint8_t *tile, uint8_t overlays) {
+    uint32_t t[2], m[2];
+    memcpy(t, tile, 8);
+    for (uint8_t k = 0; k < 4; k++) {
+      if (!(overlays & (1 << k))) continue;
+      U8X8TILESR3_READ_TILE(m, U8x8TilesR3Glyphs::overlays[k]);
+      if (k == 0) {
+        t[0] &= m[0];
+        t[1] &= m[1];
+      } else if (k < 3) {
+        t[0] |= m[0];
+        t[1] |= m[1];
+      } else {
+        t[0] ^= m[0];
+        t[1] ^= m[1];
+      }
+    }
+    if (overlays & OVERLAY_INVERT) {
+      t[0] = ~t[0];
+      t[1] = ~t[1];
+    }
+    memcpy(tile, t, 8);
+  }
+
+  static bool isBlank(const uint8_t *tile) {
+    for (uint8_t i = 0; i < 8; i++) if (tile[i]) return false;
+    return true;
+  }
+
+  /* Draw a tile held in RAM at the specified tile location */
+  void sendTile(int x, int y, uint8_t *tile) {
+    sendTiles(x, y, tile, 1, true);
+  }
+
+  /* Draw n tiles held in RAM from the specified tile location, going down or to the right.
+  * Tiles the shadow does not skip go out in runs, several tiles per drawTile call
+  * when the run lies along a display page. The tiles are used as scratch space.
+  */
+  void sendTiles(int x, int y, uint8_t *tiles, uint8_t n, bool down) {
+    uint8_t run = 0;
+    for (uint8_t i = 0; i <= n; i++) {
+      bool changed = i < n && tileChanged(down ? x : x+i, down ? y+i : y, tiles + i*8);
+#if U8X8TILESR3_STATS
+      if (i < n && !changed) apiCounters().skipped++;
+#endif
+      if (changed) {
+        run++;
+        continue;
+      }
+      if (run) {
+        uint8_t first = i - run;
+        uint8_t *data = tiles + first*8;
+        int tx = down ? x : x+first;
+        int ty = down ? y+first : y;
+        if (landscape) {
+          for (uint8_t t = 0; t < run; t++) transposeTile(data + t*8);
+        }
+        if (down != landscape) {
+          writeTiles(deviceCol(tx, ty), devicePage(tx, ty), data, run);
+        } else {
+          for (uint8_t t = 0; t < run; t++) {
+            writeTiles(deviceCol(down ? tx : tx+t, down ? ty+t : ty), devicePage(down ? tx : tx+t, down ? ty+t : ty), data + t*8, 1);
+          }
+        }
+      }
+      run = 0;
+    }
+  }
+
+  /* Display tile column and page of a tile location */
+  uint8_t deviceCol(int x, int y) const {
+    return (landscape ? x : y) - yOffset;
+  }
+
+  uint8_t devicePage(int x, int y) const {
+    return landscape ? y : xOffset - x;
+  }
+
+  /* Turn a tile stored as rows (MSB on the left) into display columns (LSB at the top),
+  * with a word-wide 8 x 8 bit transpose of the rows in reverse order
+  */
+  static void transposeTile(uint8_t *tile) {
+    uint32_t x = ((uint32_t)tile[7] << 24) | ((uint32_t)tile[6] << 16) | ((uint32_t)tile[5] << 8) | tile[4];
+    uint32_t y = ((uint32_t)tile[3] << 24) | ((uint32_t)tile[2] << 16) | ((uint32_t)tile[1] << 8) | tile[0];
+    uint32_t t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    tile[0] = t >> 24;
+    tile[1] = t >> 16;
+    tile[2] = t >> 8;
+    tile[3] = t;
+    tile[4] = y >> 24;
+    tile[5] = y >> 16;
+    tile[6] = y >> 8;
+    tile[7] = y;
+  }
+
+  /* Check a tile against the shadow and record it there,
+  * false when the panel already holds the same pixels at the specified tile location
+  */
+  bool tileChanged(int x, int y, const uint8_t *tile) {
+#if U8X8TILESR3_SHADOW != U8X8TILESR3_SHADOW_NONE
+    if (x >= 0 && x < 16 && y >= 0 && y < 16) {
+      uint8_t i = (y << 4) | x;
+      bool known = shadowKnown[i >> 3] & (1 << (i & 7));
+#if U8X8TILESR3_SHADOW == U8X8TILESR3_SHADOW_HASH
+      uint16_t h = tileHash(tile);
+      if (known && shadowHash[i] == h) return false;
+      shadowHash[i] = h;
+#else
+      if (known && memcmp(shadowTiles[i], tile, 8) == 0) return false;
+      memcpy(shadowTiles[i], tile, 8);
+#endif
+      shadowKnown[i >> 3] |= 1 << (i & 7);
+    }
+#else
+    (void)x;
+    (void)y;
+    (void)tile;
+#endif
+    return true;
+  }
+
+  /* Send n adjacent tiles to a display page, or queue them while a batch is open */
+  void writeTiles(uint8_t col, uint8_t page, uint8_t *tiles, uint8_t n) {
+#if U8X8TILESR3_BATCH_SIZE > 0
+    if (batching || async) {
+      for (uint8_t i = 0; i < n; i++) queueTile(col + i, page, tiles + i*8);
+      return;
+    }
+#endif
+    // columns do not wrap on the panel, so a run past column 255 is split
+    if (col + n > 256) {
+      uint8_t first = 256 - col;
+      transfer(col, page, first, tiles);
+      transfer(0, page, n - first, tiles + first*8);
+    } else {
+      transfer(col, page, n, tiles);
+    }
+  }
+
+  /* Send one tile n times along a display page, dropping queued tiles it covers */
+  void fillTiles(uint8_t col, uint8_t page, uint8_t n, uint8_t *tile) {
+    // columns do not wrap on the panel, so a line past column 255 is split
+    uint8_t first = col + n > 256 ? 256 - col : n;
+#if U8X8TILESR3_BATCH_SIZE > 0
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < batchCount; i++) {
+      uint8_t offset = batchCol[i] - col; // wraps past column 255 with the line
+      if (batchPage[i] == page && offset < n) continue;
+      batchCol[kept] = batchCol[i];
+      batchPage[kept] = batchPage[i];
+      memmove(batchTiles[kept], batchTiles[i], 8);
+#if U8X8TILESR3_STATS
+      batchApi[kept] = batchApi[i];
+#endif
+      kept++;
+    }
+    batchCount = kept;
+#endif
+    transfer(col, page, 1, tile, first);
+    if (first < n) transfer(0, page, 1, tile, n - first);
+  }
+
+  /* One drawTile call, or a display message repeating the tiles when repeat is more than 1,
+  * counted and timed when stats are enabled
+  */
+  void transfer(uint8_t col, uint8_t page, uint8_t n, uint8_t *tiles, uint8_t repeat = 1) {
+#if U8X8TILESR3_STATS
+    unsigned long start = micros();
+    sendToDisplay(col, page, n, tiles, repeat);
+    uint32_t spent = micros() - start;
+    U8x8TilesR3Stats::Counters &c = apiCounters();
+    c.tiles += n * repeat;
+    c.bytes += n * repeat * 8;
+    c.transfers++;
+    c.micros += spent;
+    if (spent < counters.transferMin) counters.transferMin = spent;
+    if (spent > counters.transferMax) counters.transferMax = spent;
+#else
+    sendToDisplay(col, page, n, tiles, repeat);
+#endif
+  }
+
+  void sendToDisplay(uint8_t col, uint8_t page, uint8_t n, uint8_t *tiles, uint8_t repeat) {
+    if (repeat == 1) {
+      u8x8.drawTile(col, page, n, tiles);
+      return;
+    }
+    // what u8x8's clearDisplay does: the display callback sends the data repeat times after one addressing
+    u8x8_tile_t t;
+    t.tile_ptr = tiles;
+    t.cnt = n;
+    t.x_pos = col;
+    t.y_pos = page;
+    u8x8_t *u = u8x8.getU8x8();
+    u->display_cb(u, U8X8_MSG_DISPLAY_DRAW_TILE, repeat, &t);
+  }
+
+  /* Open a batch for a multi-tile draw unless the caller already has one open */
+  bool openBatch() {
+#if U8X8TILESR3_BATCH_SIZE > 0
+    if (batching || async) return false;
+    batching = true;
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /* Send the batch if it was opened by the matching openBatch() */
+  void closeBatch(bool opened) {
+#if U8X8TILESR3_BATCH_SIZE > 0
+    if (!opened) return;
+    sendBatch();
+    batching = false;
+#else
+    (void)opened;
+#endif
+  }
+
+#if U8X8TILESR3_BATCH_SIZE > 0
+  /* Add a tile to the batch, replacing an earlier write to the same position */
+  void queueTile(uint8_t col, uint8_t page, const uint8_t *tile) {
+    for (uint8_t i = 0; i < batchCount; i++) {
+      if (batchCol[i] == col && batchPage[i] == page) {
+        memcpy(batchTiles[i], tile, 8);
+#if U8X8TILESR3_STATS
+        batchApi[i] = currentApi;
+#endif
+        return;
+      }
+    }
+    if (batchCount == U8X8TILESR3_BATCH_SIZE) {
+      if (async) {
+        sortBatch();
+        sendRun();
+      } else {
+        sendBatch();
+      }
+    }
+    batchCol[batchCount] = col;
+    batchPage[batchCount] = page;
+    memcpy(batchTiles[batchCount], tile, 8);
+#if U8X8TILESR3_STATS
+    batchApi[batchCount] = currentApi;
+#endif
+    batchCount++;
+  }
+
+  /* Sort the batch by page then column and send each run of adjacent tiles with one drawTile call */
+  void sendBatch() {
+    sortBatch();
+    while (batchCount) sendRun();
+  }
+
+  /* Insertion sort of the batch by page then column, cheap when it is already nearly sorted */
+  void sortBatch() {
+    for (uint8_t i = 1; i < batchCount; i++) {
+      uint8_t col = batchCol[i];
+      uint8_t page = batchPage[i];
+      uint8_t tile[8];
+      memcpy(tile, batchTiles[i], 8);
+#if U8X8TILESR3_STATS
+      uint8_t api = batchApi[i];
+#endif
+      uint8_t j = i;
+      while (j > 0 && (batchPage[j-1] > page || (batchPage[j-1] == page && batchCol[j-1] > col))) {
+        batchCol[j] = batchCol[j-1];
+        batchPage[j] = batchPage[j-1];
+        memcpy(batchTiles[j], batchTiles[j-1], 8);
+#if U8X8TILESR3_STATS
+        batchApi[j] = batchApi[j-1];
+#endif
+        j--;
+      }
+      batchCol[j] = col;
+      batchPage[j] = page;
+      memcpy(batchTiles[j], tile, 8);
+#if U8X8TILESR3_STATS
+      batchApi[j] = api;
+#endif
+    }
+  }
+
+  /* Number of adjacent tiles at the front of the sorted batch */
+  uint8_t runLength() const {
+    uint8_t n = 1;
+    // columns do not wrap on the panel, so a run never continues past column 255
+    while (n < batchCount && batchPage[n] == batchPage[0] && batchCol[n] == batchCol[0] + n) n++;
+    return n;
+  }
+
+  /* Send the run at the front of the sorted batch with one drawTile call and remove it.
+  * With stats, the run is counted against the draw call that queued its first tile.
+  */
+  uint8_t sendRun() {
+    uint8_t n = runLength();
+#if U8X8TILESR3_STATS
+    uint8_t api = currentApi;
+    currentApi = batchApi[0];
+    transfer(batchCol[0], batchPage[0], n, batchTiles[0]);
+    currentApi = api;
+#else
+    transfer(batchCol[0], batchPage[0], n, batchTiles[0]);
+#endif
+    batchCount -= n;
+    memmove(batchCol, batchCol + n, batchCount);
+    memmove(batchPage, batchPage + n, batchCount);
+    memmove(batchTiles, batchTiles + n, batchCount * 8);
+#if U8X8TILESR3_STATS
+    memmove(batchApi, batchApi + n, batchCount);
+#endif
+    return n;
+  }
+#endif
+
+  /* CRC-16-CCITT of the tile, the shift-and-xor form of avr-libc's _crc_ccitt_update.
+  * Any change to one or two pixels, or confined to two neighbouring bytes, always changes the result,
+  * so a pixel moving within a sparse tile such as a strip chart's is never missed.
+  */
+  static uint16_t tileHash(const uint8_t *tile) {
+    uint16_t h = 0xFFFF;
+    for (uint8_t i = 0; i < 8; i++) {
+      uint8_t d = tile[i] ^ (uint8_t)h;
+      d ^= d << 4;
+      h = (((uint16_t)d << 8) | (h >> 8)) ^ (uint8_t)(d >> 4) ^ ((uint16_t)d << 3);
+    }
+    return h;
+  }
+};
+
+// Any u8x8 display object, the U8X8 base class of every u8g2 display constructor
+typedef U8x8TilesR3Panel<U8X8> U8x8TilesR3;
+
+/* Shares one service() time budget between up to 8 panels in asynchronous mode.
+* Panels take turns to send one run of queued tiles, so a panel with a long queue
+* cannot hold back the others. Needs U8X8TILESR3_BATCH_SIZE > 0.
+*/
+template <class Display> class U8x8TilesR3Scheduler {
+public:
+  typedef U8x8TilesR3Panel<Display> Panel;
+
+  /* Add a panel to the rotation and switch it to asynchronous mode */
+  void add(Panel &panel) {
+    if (count == 8) return;
+    panel.setAsync(true);
+    panels[count++] = &panel;
+  }
+
+  /* Send queued tiles for about budget microseconds, at most one run past it.
+  * Returns the number of tiles still queued on all panels.
+  */
+  uint16_t service(unsigned long budget) {
+    unsigned long start = micros();
+    uint8_t idle = 0;
+    while (idle < count && micros() - start < budget) {
+      Panel &panel = *panels[next];
+      next = next + 1 < count ? next + 1 : 0;
+      if (panel.pending()) {
+        panel.service(0); // one run
+        idle = 0;
+      } else {
+        idle++;
+      }
+    }
+    return pending();
+  }
+
+  /* Number of tiles waiting to be sent on all panels */
+  uint16_t pending() const {
+    uint16_t n = 0;
+    for (uint8_t i = 0; i < count; i++) n += panels[i]->pending();
+    return n;
+  }
+
+private:
+  Panel *panels[8];
+  uint8_t count = 0;
+  uint8_t next = 0;
+};
+
+/* Retained-mode drawing of widgets on one panel.
+* Widgets are stacked in the order they are added, later ones on top. Each render()
+* draws only the widgets that changed, bottom to top in one batch, and also redraws any
+* widget above them that they overlap, so the top one always wins on a shared tile.
+*/
+template <class Display> class U8x8TilesR3Screen {
+public:
+  typedef U8x8TilesR3Panel<Display> Panel;
+  typedef U8x8TilesR3Widget Widget;
+
+  explicit U8x8TilesR3Screen(Panel &panel) : panel(panel) { }
+
+  /* Add a widget on top of those already added */
+  void add(Widget &w) {
+    w.next = nullptr;
+    w.dirty |= Widget::DIRTY_ALL;
+    if (top) top->next = &w;
+    else bottom = &w;
+    top = &w;
+  }
+
+  /* Draw every widget on the next render, e.g. after clearing the display */
+  void invalidate() {
+    for (Widget *w = bottom; w; w = w->next) w->dirty |= Widget::DIRTY_ALL;
+  }
+
+  /* Draw the widgets that changed. Returns the number of widgets drawn. */
+  uint8_t render() {
+    // a hidden widget uncovers whatever lies under or over it
+    for (Widget *w = bottom; w; w = w->next) {
+      if (!(w->dirty & Widget::DIRTY_CLEAR)) continue;
+      for (Widget *v = bottom; v; v = v->next) {
+        if (v != w && v->visible && v->overlaps(*w)) v->dirty |= Widget::DIRTY_ALL;
+      }
+    }
+    // a widget drawn over part of a later one makes it redraw on top
+    for (Widget *w = bottom; w; w = w->next) {
+      if (!w->dirty || !w->visible) continue;
+      for (Widget *v = w->next; v; v = v->next) {
+        if (v->visible && v->overlaps(*w)) v->dirty |= Widget::DIRTY_ALL;
+      }
+    }
+    bool batch = panel.openBatch();
+    for (Widget *w = bottom; w; w = w->next) {
+      if (w->dirty & Widget::DIRTY_CLEAR) panel.clearRegion(w->x, w->y, w->width, w->height);
+    }
+    uint8_t drawn = 0;
+    for (Widget *w = bottom; w; w = w->next) {
+      if (w->dirty && w->visible) {
+        draw(*w, w->dirty & (Widget::DIRTY_ALL | Widget::DIRTY_CLEAR));
+        drawn++;
+      }
+      w->dirty = 0;
+    }
+    panel.closeBatch(batch);
+    return drawn;
+  }
+
+private:
+  Panel &panel;
+  Widget *bottom = nullptr;
+  Widget *top = nullptr;
+
+  /* Draw one widget, every tile when full, otherwise only the tiles it knows have changed */
+  void draw(Widget &w, bool full) {
+    switch (w.type) {
+      case Widget::LABEL: {
+        U8x8TilesR3LabelWidget &label = static_cast<U8x8TilesR3LabelWidget &>(w);
+        panel.drawWord(w.x, w.y, label.text, w.width, label.overlays);
+        break;
+      }
+      case Widget::NUMBER: {
+        U8x8TilesR3NumberWidget &number = static_cast<U8x8TilesR3NumberWidget &>(w);
+        if (full) memset(number.last, 0xFF, sizeof(number.last));
+        panel.drawNumberCodes(w.x, w.y, number.last, w.width, number.value, number.format);
+        break;
+      }
+      case Widget::DIAL: {
+        U8x8TilesR3DialWidget &dial = static_cast<U8x8TilesR3DialWidget &>(w);
+        if (full) dial.dial.reset();
+        panel.drawDial(w.x, w.y, dial.dial, dial.value);
+        break;
+      }
+      case Widget::VUBAR: {
+        U8x8TilesR3VUBarWidget &bar = static_cast<U8x8TilesR3VUBarWidget &>(w);
+        if (full) bar.meter.reset();
+        panel.drawVUMeter(bar.meter, bar.value);
+        break;
+      }
+      case Widget::ICON: {
+        U8x8TilesR3IconWidget &icon = static_cast<U8x8TilesR3IconWidget &>(w);
+        panel.drawIcon(w.x, w.y, icon.tiles, w.width, w.height, icon.overlays);
+        break;
+      }
+      case Widget::CHART: {
+        U8x8TilesR3ChartWidget &chart = static_cast<U8x8TilesR3ChartWidget &>(w);
+        if (full) chart.drawn = false;
+        panel.drawChart(chart);
+        break;
+      }
+    }
+  }
 };
 
-#endif /* U8X8TILESR3_H_*/
\ No newline at end of file
+#endif /* U8X8TILESR3_H_ */
@@ -6,8 +6,9 @@
 #endif
 U8X8_SH1107_128X128_HW_I2C u8x8(/* reset=*/ 0); // replace init for diff screens
 
+#define U8X8TILESR3_SHADOW U8X8TILESR3_SHADOW_HASH // only send tiles that change
 #include "U8x8TilesR3.h"
-U8x8TilesR3 display;
+U8x8TilesR3 display(u8x8);
 
 void setup() {
   Serial.begin(115200);
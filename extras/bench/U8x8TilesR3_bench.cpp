@@ -0,0 +1,385 @@
+/*
+ * U8x8TilesR3_bench.cpp
+ *
+ * Replays typical U8x8TilesR3 workloads against the host mock display and reports,
+ * per frame, the drawTile transfers, I2C transactions, bus bytes and estimated
+ * transfer time at 100 kHz, 400 kHz and 1 MHz.
+ *
+ * Build and run from the library folder, adding any library options as -D flags:
+ *   g++ -std=gnu++11 -O2 -Iextras/host -I. extras/bench/U8x8TilesR3_bench.cpp -o bench && ./bench
+ *   g++ -std=gnu++11 -O2 -Iextras/host -I. -DU8X8TILESR3_SHADOW=U8X8TILESR3_SHADOW_HASH \
+ *       -DU8X8TILESR3_BATCH_SIZE=16 extras/bench/U8x8TilesR3_bench.cpp -o bench && ./bench
+ * With -DU8X8TILESR3_STATS=1 the screen workload also prints the library's own counters.
+ */
+
+#include <stdio.h>
+#include "MockU8x8.h"
+
+MockU8x8 u8x8;
+
+#include "U8x8TilesR3.h"
+
+static const uint32_t busClocks[3] = { 100000, 400000, 1000000 };
+
+/* Print one result row, averaged over the frames drawn by the workload */
+static void report(const char *name, uint32_t frames) {
+  printf("%-24s %6lu %8.2f %8.2f %8.1f", name, (unsigned long)frames,
+         (double)u8x8.transfers / frames, (double)u8x8.transactions / frames, (double)u8x8.busBytes / frames);
+  uint32_t hz = u8x8.getBusClock();
+  for (uint8_t i = 0; i < 3; i++) {
+    u8x8.setBusClock(busClocks[i]);
+    printf(" %9.3f", u8x8.busMicros() / frames / 1000.0);
+  }
+  u8x8.setBusClock(hz);
+  printf("\n");
+}
+
+/* Start each workload on a cleared panel with a fresh library instance and zeroed counters */
+static void start(U8x8TilesR3 &display) {
+  u8x8.clear();
+  display.invalidate();
+  u8x8.resetStats();
+#if U8X8TILESR3_STATS
+  display.resetStats();
+#endif
+}
+
+static void benchWords() {
+  static const char *words[] = { "Hello World     ", "Preset          ", "Filter Cutoff   ", "ABCDEFGHIJKLMNOP" };
+  U8x8TilesR3 display(u8x8);
+  start(display);
+  uint32_t frames = 0;
+  for (uint8_t r = 0; r < 10; r++) {
+    for (uint8_t i = 0; i < 4; i++) {
+      display.drawWord(0, 0, words[i], 16);
+      frames++;
+    }
+  }
+  report("drawWord strings", frames);
+}
+
+static void benchDialSweep() {
+  U8x8TilesR3 display(u8x8);
+  start(display);
+  uint32_t frames = 0;
+  for (int val = 0; val <= 1024; val += 4) {
+    display.drawDial9(4, 8, val);
+    frames++;
+  }
+  report("drawDial9 sweep", frames);
+}
+
+static void benchDialObject() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3Dial<9> dial;
+  start(display);
+  uint32_t frames = 0;
+  for (int val = 0; val <= 1024; val += 4) {
+    display.drawDial(4, 8, dial, val);
+    frames++;
+  }
+  report("drawDial<9> sweep", frames);
+}
+
+static void benchVURamp() {
+  U8x8TilesR3 display(u8x8);
+  start(display);
+  uint32_t frames = 0;
+  for (uint8_t r = 0; r < 4; r++) {
+    for (int val = 0; val <= 40; val++, frames++) display.drawVUBar5(2, 2, val);
+    for (int val = 40; val >= 0; val--, frames++) display.drawVUBar5(2, 2, val);
+  }
+  report("drawVUBar5 ramp", frames);
+}
+
+static void benchVUMeters() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3VUMeter meters[8] = { {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 2}, {6, 2}, {7, 2} };
+  for (uint8_t i = 0; i < 8; i++) {
+    meters[i].setPeakHold(8);
+    meters[i].setDecay(1);
+  }
+  start(display);
+  int levels[8] = {0};
+  uint32_t seed = 1;
+  uint32_t frames = 0;
+  for (; frames < 200; frames++) {
+    // audio-like levels: each channel wanders a few steps per frame
+    for (uint8_t i = 0; i < 8; i++) {
+      seed = seed * 1103515245 + 12345;
+      levels[i] += (int)((seed >> 16) % 7) - 3;
+      levels[i] = levels[i] < 0 ? 0 : (levels[i] > 40 ? 40 : levels[i]);
+    }
+    display.drawVUMeters(meters, levels, 8);
+  }
+  report("drawVUMeters 8 channels", frames);
+}
+
+static void benchCounter() {
+  U8x8TilesR3 display(u8x8);
+  start(display);
+  uint32_t frames = 0;
+  for (int val = -99; val <= 100; val++) {
+    display.draw100(10, 3, val);
+    frames++;
+  }
+  report("draw100 counter", frames);
+}
+
+static void benchNumberField() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3NumberField<5> field;
+  start(display);
+  uint32_t frames = 0;
+  for (long val = 1000; val < 1200; val++) {
+    display.drawNumberField(10, 3, field, val, 1);
+    frames++;
+  }
+  report("drawNumberField<5> 1dp", frames);
+}
+
+/* A parameter page as widgets: a title, a highlighted menu item over the title bar, a dial with its
+* value and a VU meter. Each frame the dial turns a little and the meter moves, the value changes
+* with the dial and the highlight moves every 50 frames. */
+static void benchScreen() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3Screen<U8X8> screen(display);
+  U8x8TilesR3LabelWidget title(0, 0, 16, "FILTER CUTOFF");
+  U8x8TilesR3LabelWidget item(10, 0, 6, "EDIT");
+  U8x8TilesR3DialWidget dial(2, 4);
+  U8x8TilesR3NumberWidget value(1, 8, 5, 1);
+  U8x8TilesR3VUBarWidget meter(8, 3, 5);
+  screen.add(title);
+  screen.add(item);
+  screen.add(dial);
+  screen.add(value);
+  screen.add(meter);
+  start(display);
+  uint32_t frames = 0;
+  for (int val = 0; val <= 1024; val += 4, frames++) {
+    dial.set(val);
+    value.set(val * 10 / 4);
+    meter.set((val / 4) % 41);
+    item.setOverlays(frames / 50 % 2 ? U8x8TilesR3::OVERLAY_INVERT : 0);
+    screen.render();
+#if U8X8TILESR3_STATS
+    display.endFrame();
+#endif
+  }
+  report("Screen render", frames);
+#if U8X8TILESR3_STATS
+  display.printStats(Serial);
+#endif
+}
+
+/* Three live 16 x 4 strip charts: an audio envelope of 4 samples per column, a slow sine and a
+* parameter that steps now and then. One frame adds a column to each. The full redraw sends every
+* tile of every chart each frame, as plotting with drawHeightMark or a glyph per tile does. */
+static void benchCharts(bool full, U8x8TilesR3ChartWidget::Scroll scroll) {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3Screen<U8X8> screen(display);
+  U8x8TilesR3StripChart<16, 4> envelope(0, 0), sine(0, 5), param(0, 10);
+  envelope.setSamplesPerColumn(4);
+  U8x8TilesR3ChartWidget *charts[3] = { &envelope, &sine, &param };
+  for (uint8_t i = 0; i < 3; i++) {
+    charts[i]->setScroll(scroll);
+    screen.add(*charts[i]);
+  }
+  start(display);
+  uint32_t seed = 1;
+  uint32_t frames = 0;
+  int level = 10;
+  for (; frames < 256; frames++) {
+    for (uint8_t k = 0; k < 4; k++) {
+      seed = seed * 1103515245 + 12345;
+      envelope.add(16 + (int)(12 * sin(frames * 0.1)) + (int)((seed >> 16) % 9) - 4);
+    }
+    sine.add(16 + (int)(15 * sin(frames * 0.05)));
+    if (frames % 40 == 0) level = (seed >> 20) % 32;
+    param.add(level);
+    if (full) screen.invalidate();
+    screen.render();
+  }
+  report(full ? "charts full redraw" : (scroll == U8x8TilesR3ChartWidget::SCROLL_PIXEL ? "charts pixel scroll" : "charts tile scroll"), frames);
+}
+
+/* A preset name longer than the screen scrolling through a 12-tile window at 80 pixels per second,
+* updated from a loop that runs every 5 ms. One frame is one step of the window. */
+static void benchMarquee(bool landscape, bool large) {
+  U8x8TilesR3 display(u8x8);
+  if (landscape) display.setRotation(U8x8TilesR3::ROTATE_0);
+  U8x8TilesR3Marquee marquee(2, 6, 12, large);
+  marquee.setText("Warm Analog Strings With Slow Attack");
+  marquee.setRate(80);
+  start(display);
+  uint32_t frames = 0;
+  for (uint16_t pass = 0; pass < 2000; pass++) {
+    mockDelayMicros(5000);
+    if (display.updateMarquee(marquee)) frames++;
+  }
+  report(landscape ? (large ? "marquee large landscape" : "marquee landscape") : (large ? "marquee large portrait" : "marquee portrait"), frames);
+}
+
+/* Changing UI pages: the screen is blanked, then a page of four words is drawn. */
+static void benchPageChange(bool region) {
+  static const char *words[] = { "MAIN", "FILTER", "ENVELOPE", "LFO" };
+  U8x8TilesR3 display(u8x8);
+  start(display);
+  uint32_t frames = 0;
+  for (; frames < 20; frames++) {
+    if (region) {
+      display.clearAll();
+    } else {
+      for (uint8_t t = 0; t < 255; t++) display.drawBlank(t & 15, t >> 4);
+      display.drawBlank(15, 15);
+    }
+    for (uint8_t i = 0; i < 4; i++) display.drawWord(0, (frames + i) % 4 * 4, words[(frames + i) % 4]);
+  }
+  report(region ? "page change clearAll" : "page change drawBlank", frames);
+}
+
+/* Eight step-sequencer LEDs down column 14, four clock ticks per step. The playing LED fills up over
+* its step and empties when the next one starts. Redrawing every LED each tick, as the example does,
+* is compared with an animator per LED sharing circle4Fill. One frame is one tick. */
+static void benchSequencer(bool animated) {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3Animator leds[8] = { {14, 0}, {14, 2}, {14, 4}, {14, 6}, {14, 8}, {14, 10}, {14, 12}, {14, 14} };
+  start(display);
+  uint32_t frames = 0;
+  for (; frames < 256; frames++) {
+    uint8_t step = frames / 4 % 8;
+    for (uint8_t i = 0; i < 8; i++) {
+      uint8_t frame = i == step ? frames % 4 : 0;
+      if (animated) display.drawAnimation(U8x8TilesR3Glyphs::circle4Fill, leds[i], frame);
+      else display.drawGlyph<2, 2>(14, i * 2, U8x8TilesR3Glyphs::circle4Frames[frame]);
+    }
+  }
+  report(animated ? "sequencer animators" : "sequencer redraw", frames);
+}
+
+#if U8X8TILESR3_BATCH_SIZE > 0
+/* Longest time spent in the library by one loop() pass, drawing directly or with setAsync() and
+* service(budget). Each pass does 1 ms of other work, the 8 VU meters are redrawn every 20 passes
+* and a word changes every 200. The initial full draw is not counted. */
+static void benchAsync(bool async, unsigned long budget) {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3VUMeter meters[8] = { {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 2}, {6, 2}, {7, 2} };
+  static const char *words[] = { "Preset  ", "Filter  ", "Cutoff  ", "Resonanc" };
+  int levels[8] = {0};
+  start(display);
+  display.drawVUMeters(meters, levels, 8);
+  display.drawWord(8, 0, words[0], 8);
+  display.setAsync(async);
+  u8x8.resetStats();
+  uint32_t seed = 1;
+  unsigned long worst = 0;
+  uint32_t passes = 0;
+  for (; passes < 4000; passes++) {
+    mockDelayMicros(1000);
+    unsigned long begin = micros();
+    if (passes % 20 == 0) {
+      for (uint8_t i = 0; i < 8; i++) {
+        seed = seed * 1103515245 + 12345;
+        levels[i] += (int)((seed >> 16) % 7) - 3;
+        levels[i] = levels[i] < 0 ? 0 : (levels[i] > 40 ? 40 : levels[i]);
+      }
+      display.drawVUMeters(meters, levels, 8);
+    }
+    if (passes % 200 == 100) display.drawWord(8, 0, words[(passes / 200 + 1) % 4], 8);
+    if (async) display.service(budget);
+    unsigned long spent = micros() - begin;
+    if (spent > worst) worst = spent;
+  }
+  display.setAsync(false);
+  char name[32];
+  snprintf(name, sizeof(name), async ? "async service(%lu)" : "sync", budget);
+  printf("%-24s %6lu %8lu %8.1f\n", name, (unsigned long)passes, worst, u8x8.busMicros() / 1000.0);
+}
+
+/* Three panels on their own 100 kHz buses: one redraws a whole line of text every 8 passes, the other two show
+* 4 VU meters each, redrawn every 20 passes. Each pass has a 1 ms budget, shared by the scheduler or
+* spent on each panel in turn. Reports the longest pass and the most passes the VU panels kept tiles queued. */
+static void benchPanels(bool fair) {
+  static MockU8x8 mocks[3];
+  U8x8TilesR3 panels[3] = { U8x8TilesR3(mocks[0]), U8x8TilesR3(mocks[1]), U8x8TilesR3(mocks[2]) };
+  U8x8TilesR3VUMeter meters[2][4] = { { {0, 2}, {1, 2}, {2, 2}, {3, 2} }, { {0, 2}, {1, 2}, {2, 2}, {3, 2} } };
+  static const char *words[] = { "ABCDEFGHIJKLMNOP", "QRSTUVWXYZ ABCDE" };
+  U8x8TilesR3Scheduler<U8X8> scheduler;
+  for (uint8_t p = 0; p < 3; p++) {
+    mocks[p].setBusClock(100000);
+    mocks[p].clear();
+    mocks[p].resetStats();
+    if (fair) scheduler.add(panels[p]);
+    else panels[p].setAsync(true);
+  }
+  int levels[4] = {0};
+  uint32_t seed = 1;
+  unsigned long worstPass = 0;
+  uint32_t queued[3] = { 0 }, worstQueued[3] = { 0 };
+  for (uint32_t pass = 0; pass < 2000; pass++) {
+    mockDelayMicros(1000);
+    unsigned long start = micros();
+    if (pass % 8 == 0) panels[0].drawWord(0, pass / 8 % 16, words[pass / 8 & 1], 16);
+    if (pass % 20 == 0) {
+      for (uint8_t i = 0; i < 4; i++) {
+        seed = seed * 1103515245 + 12345;
+        levels[i] = (seed >> 16) % 41;
+      }
+      panels[1].drawVUMeters(meters[0], levels, 4);
+      panels[2].drawVUMeters(meters[1], levels, 4);
+    }
+    if (fair) {
+      scheduler.service(1000);
+    } else {
+      for (uint8_t p = 0; p < 3; p++) {
+        unsigned long elapsed = micros() - start;
+        if (elapsed < 1000) panels[p].service(1000 - elapsed);
+      }
+    }
+    if (micros() - start > worstPass) worstPass = micros() - start;
+    for (uint8_t p = 0; p < 3; p++) {
+      queued[p] = panels[p].pending() ? queued[p] + 1 : 0;
+      if (queued[p] > worstQueued[p]) worstQueued[p] = queued[p];
+    }
+  }
+  printf("%-24s %6u %8lu %8lu %8lu\n", fair ? "scheduler" : "each panel in turn", 2000, worstPass,
+         (unsigned long)worstQueued[1], (unsigned long)worstQueued[2]);
+  for (uint8_t p = 0; p < 3; p++) panels[p].setAsync(false);
+}
+#endif
+
+int main() {
+  printf("U8x8TilesR3 bench: shadow %d, batch %d, sizeof(U8x8TilesR3) %lu\n",
+         U8X8TILESR3_SHADOW, U8X8TILESR3_BATCH_SIZE, (unsigned long)sizeof(U8x8TilesR3));
+  printf("%-24s %6s %8s %8s %8s %9s %9s %9s\n", "workload", "frames", "xfer/f", "i2c/f", "bytes/f",
+         "ms@100k", "ms@400k", "ms@1M");
+  benchWords();
+  benchDialSweep();
+  benchDialObject();
+  benchVURamp();
+  benchVUMeters();
+  benchCounter();
+  benchNumberField();
+  benchScreen();
+  benchCharts(true, U8x8TilesR3ChartWidget::SCROLL_PIXEL);
+  benchCharts(false, U8x8TilesR3ChartWidget::SCROLL_PIXEL);
+  benchCharts(false, U8x8TilesR3ChartWidget::SCROLL_TILE);
+  benchMarquee(false, false);
+  benchMarquee(true, false);
+  benchMarquee(true, true);
+  benchPageChange(false);
+  benchPageChange(true);
+  benchSequencer(false);
+  benchSequencer(true);
+#if U8X8TILESR3_BATCH_SIZE > 0
+  printf("\n%-24s %6s %8s %8s  (at %lu Hz)\n", "loop stall", "passes", "worst us", "bus ms",
+         (unsigned long)u8x8.getBusClock());
+  benchAsync(false, 0);
+  benchAsync(true, 1000);
+  benchAsync(true, 500);
+  printf("\n%-24s %6s %8s %8s %8s  (at 100000 Hz)\n", "3 panels", "passes", "worst us", "vu1 wait", "vu2 wait");
+  benchPanels(false);
+  benchPanels(true);
+#endif
+  return 0;
+}
@@ -0,0 +1,353 @@
+/*
+ * U8x8TilesR3_glyphc.cpp
+ *
+ * Compiles PBM glyph sheets and BDF fonts into a header of U8x8TilesR3Font glyph sets.
+ * Identical tiles across every input are stored once in a shared tile pool and glyphs
+ * refer to them by 8-bit index, or 16-bit when the pool has more than 256 tiles, so fonts
+ * that share strokes, blank halves or whole glyphs cost little more than their unique tiles.
+ * With -r the pool is also compressed, each tile as a mask of rows that repeat the previous
+ * row followed by the other rows, and is expanded one tile at a time when drawn. The flash used with and without pooling is reported on stderr.
+ *
+ * Build and run from the library folder:
+ *   g++ -std=gnu++11 -O2 extras/glyphc/U8x8TilesR3_glyphc.cpp -o glyphc
+ *   ./glyphc -n MyFont -o MyFont.h -f 65 extras/glyphc/letters.pbm
+ *
+ * Options apply to the inputs that follow them:
+ *   -n name   namespace of the generated header (default Glyphs)
+ *   -o file   output header (default stdout)
+ *   -r        compress the tile pool
+ *   -s WxH    glyph size in tiles, for PBM sheets (default 1x1)
+ *   -f code   character code of the first glyph (default 0 for PBM, 32 for BDF)
+ *
+ * A PBM sheet (P1 or P4) holds glyphs of W x H tiles left to right, then top to bottom.
+ * A BDF font is placed in cells of W x H tiles on its font bounding box baseline and covers
+ * the codes from -f up to its highest encoding below 256, missing codes drawing blank.
+ * Each input becomes a U8x8TilesR3Font named after its file, e.g. letters.pbm gives
+ * MyFont::letters, drawn with display.drawString(x, y, MyFont::letters, "HELLO").
+ *
+ * U8x8TilesR3_glyphc.cpp is licensed under Creative Commons Zero v1.0 Universal.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <map>
+
+typedef std::vector<uint8_t> Tile; // 8 rows, bit 7 is the leftmost pixel
+
+struct GlyphSet {
+  std::string name;
+  std::string source;
+  uint8_t first;
+  uint8_t width;
+  uint8_t height;
+  std::vector<std::vector<Tile> > glyphs; // tiles of each glyph, row by row
+};
+
+/* A monochrome image, 1 for a set pixel */
+struct Bitmap {
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> pixels;
+  bool at(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height && pixels[y * width + x]; }
+};
+
+static void fail(const char *msg, const char *arg) {
+  fprintf(stderr, "glyphc: %s %s\n", msg, arg);
+  exit(1);
+}
+
+/* Next PBM header number, skipping white space and comments */
+static int pbmNumber(FILE *f) {
+  int c = fgetc(f);
+  while (c == '#' || isspace(c)) {
+    if (c == '#') while (c != '\n' && c != EOF) c = fgetc(f);
+    c = fgetc(f);
+  }
+  int n = 0;
+  for (; isdigit(c); c = fgetc(f)) n = n * 10 + c - '0';
+  return n;
+}
+
+static Bitmap readPbm(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) fail("cannot open", path);
+  Bitmap bm;
+  char magic[2] = { 0, 0 };
+  if (fread(magic, 1, 2, f) != 2 || magic[0] != 'P' || (magic[1] != '1' && magic[1] != '4')) fail("not a P1 or P4 PBM:", path);
+  bm.width = pbmNumber(f);
+  bm.height = pbmNumber(f);
+  bm.pixels.resize(bm.width * bm.height);
+  int byte = 0;
+  for (int y = 0; y < bm.height; y++) {
+    for (int x = 0; x < bm.width; x++) {
+      if (magic[1] == '1') {
+        int c = fgetc(f);
+        while (isspace(c)) c = fgetc(f);
+        if (c == EOF) fail("truncated PBM", path);
+        bm.pixels[y * bm.width + x] = c == '1';
+      } else {
+        if (x % 8 == 0 && (byte = fgetc(f)) == EOF) fail("truncated PBM", path);
+        bm.pixels[y * bm.width + x] = (byte >> (7 - x % 8)) & 1;
+      }
+    }
+  }
+  fclose(f);
+  return bm;
+}
+
+/* Cut the tiles of a glyph with its top left pixel at (x0, y0) */
+static std::vector<Tile> cutGlyph(const Bitmap &bm, int x0, int y0, uint8_t width, uint8_t height) {
+  std::vector<Tile> tiles;
+  for (int ty = 0; ty < height; ty++) {
+    for (int tx = 0; tx < width; tx++) {
+      Tile tile(8, 0);
+      for (int r = 0; r < 8; r++) {
+        for (int c = 0; c < 8; c++) {
+          if (bm.at(x0 + tx * 8 + c, y0 + ty * 8 + r)) tile[r] |= 0x80 >> c;
+        }
+      }
+      tiles.push_back(tile);
+    }
+  }
+  return tiles;
+}
+
+static void loadPbm(GlyphSet &set) {
+  Bitmap bm = readPbm(set.source.c_str());
+  int cellW = set.width * 8;
+  int cellH = set.height * 8;
+  if (bm.width % cellW || bm.height % cellH) fail("sheet size is not a multiple of the glyph size:", set.source.c_str());
+  for (int y = 0; y < bm.height; y += cellH) {
+    for (int x = 0; x < bm.width; x += cellW) set.glyphs.push_back(cutGlyph(bm, x, y, set.width, set.height));
+  }
+}
+
+static void loadBdf(GlyphSet &set) {
+  FILE *f = fopen(set.source.c_str(), "r");
+  if (!f) fail("cannot open", set.source.c_str());
+  int cellW = set.width * 8;
+  int cellH = set.height * 8;
+  int boxX = 0, boxY = 0, boxW = 0, boxH = 0;
+  std::map<int, Bitmap> chars;
+  char line[256];
+  int encoding = -1, w = 0, h = 0, xo = 0, yo = 0;
+  while (fgets(line, sizeof(line), f)) {
+    if (sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &boxW, &boxH, &boxX, &boxY) == 4) continue;
+    if (sscanf(line, "ENCODING %d", &encoding) == 1) continue;
+    if (sscanf(line, "BBX %d %d %d %d", &w, &h, &xo, &yo) == 4) continue;
+    if (strncmp(line, "BITMAP", 6) != 0) continue;
+    // place the glyph in its cell, on the baseline given by the font bounding box
+    Bitmap cell;
+    cell.width = cellW;
+    cell.height = cellH;
+    cell.pixels.assign(cellW * cellH, 0);
+    int top = cellH + boxY - yo - h;
+    for (int r = 0; r < h && fgets(line, sizeof(line), f); r++) {
+      for (int c = 0; c < w; c++) {
+        char hex[2] = { line[c / 4], 0 };
+        int nibble = (int)strtol(hex, 0, 16);
+        int x = xo - boxX + c;
+        int y = top + r;
+        if ((nibble >> (3 - c % 4)) & 1 && x >= 0 && x < cellW && y >= 0 && y < cellH) cell.pixels[y * cellW + x] = 1;
+      }
+    }
+    if (encoding >= set.first && encoding < 256) chars[encoding] = cell;
+    encoding = -1;
+  }
+  fclose(f);
+  if (chars.empty()) fail("no glyphs from the first code in", set.source.c_str());
+  if (boxW > cellW || boxH > cellH) fprintf(stderr, "glyphc: %s is clipped to %d x %d pixels\n", set.source.c_str(), cellW, cellH);
+  Bitmap blank;
+  for (int code = set.first; code <= chars.rbegin()->first; code++) {
+    std::map<int, Bitmap>::const_iterator it = chars.find(code);
+    set.glyphs.push_back(cutGlyph(it == chars.end() ? blank : it->second, 0, 0, set.width, set.height));
+  }
+}
+
+/* Compressed form of a tile: a mask of rows repeating the previous row, then the other rows */
+static Tile compress(const Tile &tile) {
+  Tile out(1, 0);
+  uint8_t row = 0;
+  for (int i = 0; i < 8; i++) {
+    if (tile[i] == row) {
+      out[0] |= 0x80 >> i;
+    } else {
+      row = tile[i];
+      out.push_back(row);
+    }
+  }
+  return out;
+}
+
+/* The decoder of U8x8TilesR3Font::readTile, to check the compressed pool */
+static Tile expand(const std::vector<uint8_t> &data, const std::vector<uint16_t> &blocks, size_t index) {
+  size_t src = blocks[index / 8];
+  for (size_t k = index & 7; k > 0; k--) src += 9 - __builtin_popcount(data[src]);
+  uint8_t mask = data[src++];
+  Tile tile(8, 0);
+  uint8_t row = 0;
+  for (int i = 0; i < 8; i++, mask <<= 1) {
+    if (!(mask & 0x80)) row = data[src++];
+    tile[i] = row;
+  }
+  return tile;
+}
+
+static std::string stem(const std::string &path) {
+  size_t slash = path.find_last_of("/\\");
+  std::string name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+  name = name.substr(0, name.find('.'));
+  for (size_t i = 0; i < name.size(); i++) {
+    if (!isalnum((unsigned char)name[i])) name[i] = '_';
+  }
+  if (name.empty() || isdigit((unsigned char)name[0])) name = "glyphs_" + name;
+  return name;
+}
+
+template <class T> static void writeNumbers(FILE *out, const T *data, size_t n) {
+  for (size_t i = 0; i < n; i++) fprintf(out, "%s%d", i ? ", " : "", (int)data[i]);
+}
+
+int main(int argc, char **argv) {
+  std::string space = "Glyphs";
+  const char *outPath = 0;
+  bool rle = false;
+  int width = 1, height = 1, first = -1;
+  std::vector<GlyphSet> sets;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "-n" && hasValue) space = argv[++i];
+    else if (arg == "-o" && hasValue) outPath = argv[++i];
+    else if (arg == "-r") rle = true;
+    else if (arg == "-s" && hasValue) {
+      if (sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width < 1 || height < 1 || width * height > 64) fail("bad glyph size", argv[i]);
+    }
+    else if (arg == "-f" && hasValue) {
+      if (sscanf(argv[++i], "%d", &first) != 1 || first < 0 || first > 255) fail("bad first code", argv[i]);
+    }
+    else if (arg[0] == '-') fail("unknown option", argv[i]);
+    else {
+      GlyphSet set;
+      set.name = stem(arg);
+      set.source = arg;
+      set.width = width;
+      set.height = height;
+      bool bdf = arg.size() > 4 && arg.compare(arg.size() - 4, 4, ".bdf") == 0;
+      set.first = first >= 0 ? first : (bdf ? 32 : 0);
+      if (bdf) loadBdf(set);
+      else loadPbm(set);
+      if (set.glyphs.size() + set.first > 256) fail("more glyphs than character codes in", argv[i]);
+      sets.push_back(set);
+    }
+  }
+  if (sets.empty()) {
+    fprintf(stderr, "usage: glyphc [-n name] [-o out.h] [-r] [-s WxH] [-f first] input.pbm|input.bdf ...\n");
+    return 1;
+  }
+
+  // pool the unique tiles of every glyph set
+  std::vector<Tile> pool;
+  std::map<Tile, uint16_t> poolIndex;
+  std::vector<std::vector<uint16_t> > indices(sets.size());
+  size_t rawBytes = 0;
+  for (size_t s = 0; s < sets.size(); s++) {
+    for (size_t g = 0; g < sets[s].glyphs.size(); g++) {
+      for (size_t t = 0; t < sets[s].glyphs[g].size(); t++) {
+        const Tile &tile = sets[s].glyphs[g][t];
+        std::map<Tile, uint16_t>::const_iterator it = poolIndex.find(tile);
+        if (it == poolIndex.end()) {
+          // the pool is addressed with 16 bits, like the rest of flash on an AVR
+          if (pool.size() == 8192) fail("more than 8192 unique tiles, split the inputs across headers", "");
+          it = poolIndex.insert(std::make_pair(tile, (uint16_t)pool.size())).first;
+          pool.push_back(tile);
+        }
+        indices[s].push_back(it->second);
+        rawBytes += 8;
+      }
+    }
+  }
+
+  std::vector<uint8_t> data;
+  std::vector<uint16_t> blocks;
+  for (size_t i = 0; i < pool.size(); i++) {
+    if (i % 8 == 0) blocks.push_back(data.size());
+    Tile packed = compress(pool[i]);
+    data.insert(data.end(), packed.begin(), packed.end());
+  }
+  for (size_t i = 0; i < pool.size(); i++) {
+    if (expand(data, blocks, i) != pool[i]) fail("compressed pool does not round trip", "");
+  }
+  if (rle && data.size() > 65535) fail("compressed pool is over 64 KB, split the inputs across headers", "");
+  bool wide = pool.size() > 256;
+  size_t plainPool = pool.size() * 8;
+  size_t packedPool = data.size() + blocks.size() * 2;
+  if (rle && packedPool >= plainPool) {
+    fprintf(stderr, "glyphc: compression does not help these glyphs, writing a plain pool\n");
+    rle = false;
+  }
+
+  FILE *out = outPath ? fopen(outPath, "w") : stdout;
+  if (!out) fail("cannot write", outPath);
+  std::string guard = space;
+  for (size_t i = 0; i < guard.size(); i++) guard[i] = toupper((unsigned char)guard[i]);
+  fprintf(out, "/*\n * %s glyphs generated by U8x8TilesR3_glyphc from", space.c_str());
+  for (size_t s = 0; s < sets.size(); s++) fprintf(out, " %s", sets[s].source.c_str());
+  fprintf(out, "\n * Include after U8x8TilesR3.h.\n */\n\n#ifndef %s_GLYPHS_H_\n#define %s_GLYPHS_H_\n\n", guard.c_str(), guard.c_str());
+  fprintf(out, "namespace %s {\n", space.c_str());
+  if (rle) {
+    fprintf(out, "  constexpr uint8_t tiles[%lu] U8X8TILESR3_PROGMEM = {\n    ", (unsigned long)data.size());
+    for (size_t i = 0; i < pool.size(); i++) {
+      Tile packed = compress(pool[i]);
+      if (i) fprintf(out, ",%s", i % 8 ? " " : "\n    ");
+      writeNumbers(out, &packed[0], packed.size());
+    }
+    fprintf(out, "\n  };\n  constexpr uint16_t blocks[%lu] U8X8TILESR3_PROGMEM = { ", (unsigned long)blocks.size());
+    for (size_t i = 0; i < blocks.size(); i++) fprintf(out, "%s%u", i ? ", " : "", blocks[i]);
+    fprintf(out, " };\n");
+  } else {
+    fprintf(out, "  constexpr uint8_t tiles[%lu][8] U8X8TILESR3_PROGMEM = {\n", (unsigned long)pool.size());
+    for (size_t i = 0; i < pool.size(); i++) {
+      fprintf(out, "%s{ ", i % 4 ? " " : "    ");
+      writeNumbers(out, &pool[i][0], 8);
+      fprintf(out, " }%s", i + 1 == pool.size() ? "\n" : (i % 4 == 3 ? ",\n" : ","));
+    }
+    fprintf(out, "  };\n");
+  }
+  for (size_t s = 0; s < sets.size(); s++) {
+    const GlyphSet &set = sets[s];
+    size_t perGlyph = set.width * set.height;
+    fprintf(out, "  // %s, codes %d - %d\n", set.source.c_str(), set.first, (int)(set.first + set.glyphs.size() - 1));
+    fprintf(out, "  constexpr %s %sGlyphs[%lu][%lu] U8X8TILESR3_PROGMEM = {\n    ", wide ? "uint16_t" : "uint8_t",
+            set.name.c_str(), (unsigned long)set.glyphs.size(), (unsigned long)perGlyph);
+    for (size_t g = 0; g < set.glyphs.size(); g++) {
+      fprintf(out, "%s{ ", g ? (g % 8 ? ", " : ",\n    ") : "");
+      writeNumbers(out, &indices[s][g * perGlyph], perGlyph);
+      fprintf(out, " }");
+    }
+    fprintf(out, "\n  };\n");
+    std::string glyphs = set.name + "Glyphs[0]";
+    fprintf(out, "  constexpr U8x8TilesR3Font %s = { %s, %s, %s, %d, %lu, %d, %d, %s };\n", set.name.c_str(),
+            rle ? "tiles" : "tiles[0]", rle ? "blocks" : "nullptr", wide ? "nullptr" : glyphs.c_str(), set.first,
+            (unsigned long)set.glyphs.size(), set.width, set.height, wide ? glyphs.c_str() : "nullptr");
+  }
+  fprintf(out, "}\n\n#endif /* %s_GLYPHS_H_ */\n", guard.c_str());
+  if (outPath) fclose(out);
+
+  size_t indexBytes = 0;
+  for (size_t s = 0; s < sets.size(); s++) indexBytes += indices[s].size() * (wide ? 2 : 1);
+  size_t total = (rle ? packedPool : plainPool) + indexBytes;
+  fprintf(stderr, "glyphc: %lu tiles in %lu glyph sets, %lu unique\n", (unsigned long)(rawBytes / 8),
+          (unsigned long)sets.size(), (unsigned long)pool.size());
+  fprintf(stderr, "  tables of whole tiles   %6lu bytes\n", (unsigned long)rawBytes);
+  fprintf(stderr, "  pool + indices          %6lu bytes\n", (unsigned long)(plainPool + indexBytes));
+  fprintf(stderr, "  compressed pool+indices %6lu bytes\n", (unsigned long)(packedPool + indexBytes));
+  fprintf(stderr, "  written                 %6lu bytes, %.1f%% saved\n", (unsigned long)total,
+          100.0 * ((double)rawBytes - total) / rawBytes);
+  return 0;
+}
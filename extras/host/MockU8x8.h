@@ -0,0 +1,207 @@
+/*
+ * MockU8x8.h
+ *
+ * A host-side (Linux/macOS) stand-in for the u8x8 display object used by U8x8TilesR3.h,
+ * so the library can be built and measured without an SH1107 board.
+ *
+ * Every drawTile call is routed through a u8x8-style display callback, as in u8g2,
+ * recorded into a copy of the panel memory, and costed as I2C traffic using the
+ * transfer pattern of u8x8's fast SSD13xx/SH1107 I2C driver:
+ * one command transaction (address, control byte, 3 addressing commands) per drawTile,
+ * then the pixel data in transactions of at most 24 bytes (address + control byte + data).
+ *
+ * Include this before U8x8TilesR3.h and declare `MockU8x8 u8x8;` then `U8x8TilesR3 display(u8x8);`, as a sketch would.
+ * Any number of mock displays can be driven at once, each with its own panel and counters.
+ *
+ * MockU8x8.h is licensed under Creative Commons Zero v1.0 Universal.
+ */
+
+#ifndef MOCKU8X8_H_
+#define MOCKU8X8_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// The parts of u8x8.h that the library and this mock use
+typedef struct u8x8_struct u8x8_t;
+typedef uint8_t (*u8x8_msg_cb)(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+struct u8x8_struct {
+  u8x8_msg_cb display_cb;
+  void *user_ptr;
+};
+typedef struct u8x8_tile_struct {
+  uint8_t *tile_ptr;
+  uint8_t cnt;
+  uint8_t x_pos;
+  uint8_t y_pos;
+} u8x8_tile_t;
+#define U8X8_MSG_DISPLAY_DRAW_TILE 15
+
+// Simulated clock behind micros(), advanced by the bus time of every transfer on any mock display.
+// Add the time of other work in the loop with mockDelayMicros().
+static double mockMicrosNow = 0;
+
+inline unsigned long micros() { return (unsigned long)mockMicrosNow; }
+inline void mockDelayMicros(double us) { mockMicrosNow += us; }
+
+/* Minimal Arduino String, enough for the String overloads of the library */
+class String {
+public:
+  String(const char *s = "") : str(s) { }
+  void toCharArray(char *buf, unsigned int bufsize) const {
+    if (bufsize == 0) return;
+    strncpy(buf, str, bufsize - 1);
+    buf[bufsize - 1] = 0;
+  }
+  const char *c_str() const { return str; }
+  unsigned int length() const { return strlen(str); }
+private:
+  const char *str;
+};
+
+/* Minimal Arduino Serial printing to stdout, enough for printStats(Serial) */
+class MockSerial {
+public:
+  void print(const char *s) { fputs(s, stdout); }
+  void print(char c) { putchar(c); }
+  void print(unsigned long n) { printf("%lu", n); }
+  void println() { putchar('\n'); }
+  template <class T> void println(T value) {
+    print(value);
+    println();
+  }
+};
+
+static MockSerial Serial __attribute__((unused));
+
+class MockU8x8 {
+public:
+  static const uint8_t I2C_ADDRESS_BYTES = 1;
+  static const uint8_t I2C_CONTROL_BYTES = 1;
+  static const uint8_t I2C_COMMAND_BYTES = 3;  // column high, column low, page
+  static const uint8_t I2C_DATA_CHUNK = 24;
+
+  // Transfer counters since the last resetStats()
+  uint32_t transfers = 0;    // drawTile calls (display callback messages)
+  uint32_t transactions = 0; // I2C start/stop transactions
+  uint32_t tiles = 0;        // 8 x 8 tiles written to the panel
+  uint32_t pixelBytes = 0;   // tile data bytes
+  uint32_t busBytes = 0;     // every byte on the bus, including addresses and commands
+
+  MockU8x8(uint32_t hz = 400000) : busHz(hz) {
+    u8x8.display_cb = displayCb;
+    u8x8.user_ptr = this;
+    memset(panel, 0, sizeof(panel));
+  }
+
+  void begin() { clear(); }
+
+  /* Clear the panel as u8x8 does, one repeated blank tile per page.
+  * The whole of the panel copy is blanked, including the columns past 15 that
+  * offset coordinates wrap to.
+  */
+  void clear() {
+    uint8_t blank[8] = {0};
+    u8x8_tile_t tile = { blank, 1, 0, 0 };
+    for (uint8_t page = 0; page < 16; page++) {
+      tile.y_pos = page;
+      u8x8.display_cb(&u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 16, &tile);
+    }
+    memset(panel, 0, sizeof(panel));
+  }
+
+  void drawTile(uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr) {
+    u8x8_tile_t tile = { tile_ptr, cnt, x, y };
+    u8x8.display_cb(&u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, &tile);
+  }
+
+  /* In flip mode the controller shows its memory turned by 180 degrees,
+  * so later tiles land mirrored in column and page with their bits reversed
+  */
+  void setFlipMode(uint8_t mode) { flipMode = mode; }
+  uint8_t getFlipMode() const { return flipMode; }
+
+  /* Set the panel height that flip mode mirrors pages over, 16 for 128 x 128 or 8 for 128 x 64 */
+  void setPages(uint8_t count) { pages = count; }
+  uint8_t getPages() const { return pages; }
+
+  u8x8_t *getU8x8() { return &u8x8; }
+
+  /* Set the simulated I2C clock, e.g. 100000, 400000 or 1000000 */
+  void setBusClock(uint32_t hz) { busHz = hz; }
+  uint32_t getBusClock() const { return busHz; }
+
+  /* Bus time of everything sent since resetStats(), in microseconds */
+  double busMicros() const {
+    return busTime(busBytes, transactions);
+  }
+
+  /* Each byte costs 9 clocks (8 bits and ACK) and each transaction 2 more for start and stop */
+  double busTime(uint32_t bytes, uint32_t txns) const {
+    return (bytes * 9.0 + txns * 2.0) * 1000000.0 / busHz;
+  }
+
+  void resetStats() {
+    transfers = transactions = tiles = pixelBytes = busBytes = 0;
+  }
+
+  /* Contents of the panel at tile column col (0 - 255) of page (0 - 15), as shown in the controller's orientation */
+  const uint8_t *tileAt(uint8_t col, uint8_t page) const {
+    return panel[page & 15][col];
+  }
+
+private:
+  u8x8_t u8x8;
+  uint32_t busHz;
+  uint8_t flipMode = 0;
+  uint8_t pages = 16;
+  uint8_t panel[16][256][8];
+
+  static uint8_t displayCb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr) {
+    if (msg == U8X8_MSG_DISPLAY_DRAW_TILE) ((MockU8x8 *)u8x8->user_ptr)->record((u8x8_tile_t *)arg_ptr, arg_int);
+    return 1;
+  }
+
+  /* Store a tile message, its data repeated arg_int times along the page, and cost its transfer */
+  void record(const u8x8_tile_t *tile, uint8_t repeat) {
+    uint32_t bytes = busBytes;
+    uint32_t txns = transactions;
+    uint8_t col = tile->x_pos;
+    for (uint8_t r = 0; r < repeat; r++) {
+      for (uint8_t i = 0; i < tile->cnt; i++) {
+        if (flipMode) storeFlipped(tile->tile_ptr + i * 8, col++, tile->y_pos);
+        else memcpy(panel[tile->y_pos & 15][col++], tile->tile_ptr + i * 8, 8);
+      }
+      // each repeat is one data send, split into I2C transactions of at most 24 bytes
+      uint16_t data = tile->cnt * 8;
+      uint16_t chunks = (data + I2C_DATA_CHUNK - 1) / I2C_DATA_CHUNK;
+      transactions += chunks;
+      busBytes += data + chunks * (I2C_ADDRESS_BYTES + I2C_CONTROL_BYTES);
+      pixelBytes += data;
+      tiles += tile->cnt;
+    }
+    transfers++;
+    transactions++;
+    busBytes += I2C_ADDRESS_BYTES + I2C_CONTROL_BYTES + I2C_COMMAND_BYTES;
+    mockMicrosNow += busTime(busBytes - bytes, transactions - txns);
+  }
+
+  /* Store a tile as flip mode shows it, at the mirrored column of the 16 and page of the panel height */
+  void storeFlipped(const uint8_t *data, uint8_t col, uint8_t page) {
+    uint8_t *shown = panel[(pages - 1 - page) & 15][(uint8_t)(15 - col)];
+    for (uint8_t i = 0; i < 8; i++) {
+      uint8_t b = data[7 - i];
+      b = (b >> 4) | (b << 4);
+      b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+      shown[i] = ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+    }
+  }
+};
+
+// The library's default U8x8TilesR3 draws on a U8X8, the base class of the u8g2 display objects
+typedef MockU8x8 U8X8;
+
+#endif /* MOCKU8X8_H_ */
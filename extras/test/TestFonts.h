@@ -0,0 +1,63 @@
+/*
+ * TestFonts glyphs generated by U8x8TilesR3_glyphc from extras/glyphc/letters.pbm extras/glyphc/digits.pbm extras/glyphc/letters4.pbm
+ * Include after U8x8TilesR3.h.
+ */
+
+#ifndef TESTFONTS_GLYPHS_H_
+#define TESTFONTS_GLYPHS_H_
+
+namespace TestFonts {
+  constexpr uint8_t tiles[107][8] U8X8TILESR3_PROGMEM = {
+    { 0, 56, 68, 68, 124, 68, 68, 0 }, { 0, 120, 68, 68, 120, 68, 124, 0 }, { 0, 56, 68, 64, 64, 68, 56, 0 }, { 0, 120, 68, 68, 68, 68, 120, 0 },
+    { 0, 124, 64, 64, 120, 64, 124, 0 }, { 0, 124, 64, 64, 120, 64, 64, 0 }, { 0, 56, 68, 64, 92, 68, 56, 0 }, { 0, 68, 68, 68, 124, 68, 68, 0 },
+    { 0, 124, 16, 16, 16, 16, 124, 0 }, { 0, 4, 4, 4, 4, 68, 56, 0 }, { 0, 68, 72, 112, 112, 72, 68, 0 }, { 0, 64, 64, 64, 64, 64, 124, 0 },
+    { 0, 68, 108, 84, 68, 68, 68, 0 }, { 0, 68, 100, 84, 76, 68, 68, 0 }, { 0, 56, 68, 68, 68, 68, 56, 0 }, { 0, 120, 68, 68, 120, 64, 64, 0 },
+    { 0, 56, 68, 68, 84, 76, 60, 0 }, { 0, 120, 68, 68, 120, 72, 68, 0 }, { 0, 56, 68, 32, 24, 68, 56, 0 }, { 0, 124, 16, 16, 16, 16, 16, 0 },
+    { 0, 68, 68, 68, 68, 68, 56, 0 }, { 0, 68, 68, 68, 68, 40, 16, 0 }, { 0, 68, 68, 84, 84, 84, 40, 0 }, { 0, 68, 68, 40, 16, 40, 68, 0 },
+    { 0, 68, 68, 40, 16, 16, 16, 0 }, { 0, 124, 4, 8, 16, 32, 124, 0 }, { 0, 48, 80, 16, 16, 16, 124, 0 }, { 0, 56, 68, 8, 16, 32, 124, 0 },
+    { 0, 56, 68, 4, 24, 68, 56, 0 }, { 0, 8, 24, 40, 72, 124, 8, 0 }, { 0, 124, 64, 56, 4, 68, 56, 0 }, { 0, 56, 64, 120, 68, 68, 56, 0 },
+    { 0, 124, 4, 8, 16, 32, 64, 0 }, { 0, 56, 68, 56, 68, 68, 56, 0 }, { 0, 56, 68, 68, 60, 4, 56, 0 }, { 0, 3, 7, 28, 56, 56, 112, 127 },
+    { 0, 192, 224, 56, 28, 28, 14, 254 }, { 127, 96, 96, 96, 96, 96, 96, 96 }, { 254, 6, 6, 6, 6, 6, 6, 6 }, { 0, 127, 127, 96, 96, 96, 96, 127 },
+    { 0, 248, 252, 12, 6, 6, 12, 252 }, { 127, 96, 96, 96, 96, 96, 127, 127 }, { 248, 12, 6, 6, 6, 12, 252, 248 }, { 0, 15, 31, 56, 112, 96, 96, 96 },
+    { 0, 248, 252, 14, 6, 6, 0, 0 }, { 96, 96, 96, 96, 112, 56, 31, 15 }, { 0, 0, 0, 6, 6, 14, 252, 248 }, { 0, 127, 127, 96, 96, 96, 96, 96 },
+    { 0, 248, 252, 12, 6, 6, 6, 6 }, { 96, 96, 96, 96, 96, 96, 127, 127 }, { 6, 6, 6, 6, 6, 12, 252, 248 }, { 0, 254, 254, 0, 0, 0, 0, 248 },
+    { 248, 0, 0, 0, 0, 0, 254, 254 }, { 248, 0, 0, 0, 0, 0, 0, 0 }, { 0, 31, 63, 112, 96, 96, 96, 96 }, { 0, 254, 254, 0, 0, 0, 0, 124 },
+    { 96, 96, 96, 96, 96, 112, 63, 31 }, { 126, 6, 6, 6, 6, 14, 254, 252 }, { 0, 96, 96, 96, 96, 96, 96, 127 }, { 0, 6, 6, 6, 6, 6, 6, 254 },
+    { 0, 31, 31, 1, 1, 1, 1, 1 }, { 0, 248, 248, 128, 128, 128, 128, 128 }, { 1, 1, 1, 1, 1, 1, 31, 31 }, { 128, 128, 128, 128, 128, 128, 248, 248 },
+    { 0, 0, 0, 0, 0, 0, 0, 0 }, { 0, 62, 62, 6, 6, 6, 6, 6 }, { 0, 0, 0, 96, 96, 112, 63, 31 }, { 0, 96, 96, 96, 97, 103, 126, 120 },
+    { 0, 6, 30, 120, 224, 128, 0, 0 }, { 120, 124, 102, 103, 97, 96, 96, 96 }, { 0, 0, 0, 128, 224, 120, 30, 6 }, { 0, 96, 96, 96, 96, 96, 96, 96 },
+    { 0, 0, 0, 0, 0, 0, 254, 254 }, { 0, 96, 120, 126, 103, 97, 97, 97 }, { 0, 6, 30, 126, 230, 134, 134, 134 }, { 96, 96, 96, 96, 96, 96, 96, 96 },
+    { 6, 6, 6, 6, 6, 6, 6, 6 }, { 0, 96, 96, 96, 120, 126, 103, 97 }, { 0, 6, 6, 6, 6, 6, 134, 230 }, { 126, 30, 6, 6, 6, 6, 6, 6 },
+    { 0, 252, 254, 14, 6, 6, 6, 6 }, { 6, 6, 6, 6, 6, 14, 254, 252 }, { 0, 252, 254, 14, 6, 6, 14, 252 }, { 6, 198, 230, 118, 62, 30, 254, 252 },
+    { 127, 124, 111, 99, 96, 96, 96, 96 }, { 248, 0, 0, 192, 240, 60, 14, 6 }, { 0, 31, 63, 112, 96, 96, 96, 63 }, { 0, 248, 252, 14, 6, 0, 0, 252 },
+    { 31, 0, 0, 0, 96, 112, 63, 31 }, { 254, 14, 6, 6, 6, 14, 252, 248 }, { 0, 127, 127, 1, 1, 1, 1, 1 }, { 0, 254, 254, 128, 128, 128, 128, 128 },
+    { 1, 1, 1, 1, 1, 1, 1, 1 }, { 128, 128, 128, 128, 128, 128, 128, 128 }, { 0, 6, 6, 6, 6, 6, 6, 6 }, { 96, 96, 96, 112, 56, 30, 7, 1 },
+    { 6, 6, 6, 14, 28, 120, 224, 128 }, { 96, 96, 97, 97, 103, 126, 120, 96 }, { 6, 6, 134, 134, 230, 126, 30, 6 }, { 0, 96, 96, 96, 96, 120, 30, 7 },
+    { 0, 6, 6, 6, 6, 30, 120, 224 }, { 1, 7, 30, 120, 96, 96, 96, 96 }, { 224, 248, 30, 6, 6, 6, 6, 6 }, { 0, 127, 127, 0, 0, 0, 0, 1 },
+    { 0, 254, 254, 6, 6, 30, 120, 224 }, { 7, 30, 120, 96, 96, 96, 127, 127 }, { 128, 0, 0, 0, 0, 0, 254, 254 }
+  };
+  // extras/glyphc/letters.pbm, codes 65 - 90
+  constexpr uint8_t lettersGlyphs[26][1] U8X8TILESR3_PROGMEM = {
+    { 0 }, { 1 }, { 2 }, { 3 }, { 4 }, { 5 }, { 6 }, { 7 },
+    { 8 }, { 9 }, { 10 }, { 11 }, { 12 }, { 13 }, { 14 }, { 15 },
+    { 16 }, { 17 }, { 18 }, { 19 }, { 20 }, { 21 }, { 22 }, { 23 },
+    { 24 }, { 25 }
+  };
+  constexpr U8x8TilesR3Font letters = { tiles[0], nullptr, lettersGlyphs[0], 65, 26, 1, 1, nullptr };
+  // extras/glyphc/digits.pbm, codes 48 - 57
+  constexpr uint8_t digitsGlyphs[10][1] U8X8TILESR3_PROGMEM = {
+    { 14 }, { 26 }, { 27 }, { 28 }, { 29 }, { 30 }, { 31 }, { 32 },
+    { 33 }, { 34 }
+  };
+  constexpr U8x8TilesR3Font digits = { tiles[0], nullptr, digitsGlyphs[0], 48, 10, 1, 1, nullptr };
+  // extras/glyphc/letters4.pbm, codes 65 - 90
+  constexpr uint8_t letters4Glyphs[26][4] U8X8TILESR3_PROGMEM = {
+    { 35, 36, 37, 38 }, { 39, 40, 41, 42 }, { 43, 44, 45, 46 }, { 47, 48, 49, 50 }, { 39, 51, 41, 52 }, { 39, 51, 37, 53 }, { 54, 55, 56, 57 }, { 58, 59, 37, 38 },
+    { 60, 61, 62, 63 }, { 64, 65, 66, 50 }, { 67, 68, 69, 70 }, { 71, 64, 49, 72 }, { 73, 74, 75, 76 }, { 77, 78, 75, 79 }, { 54, 80, 56, 81 }, { 39, 82, 37, 53 },
+    { 54, 80, 56, 83 }, { 39, 40, 84, 85 }, { 86, 87, 88, 89 }, { 90, 91, 92, 93 }, { 71, 94, 56, 81 }, { 71, 94, 95, 96 }, { 71, 94, 97, 98 }, { 99, 100, 101, 102 },
+    { 99, 100, 92, 93 }, { 103, 104, 105, 106 }
+  };
+  constexpr U8x8TilesR3Font letters4 = { tiles[0], nullptr, letters4Glyphs[0], 65, 26, 2, 2, nullptr };
+}
+
+#endif /* TESTFONTS_GLYPHS_H_ */
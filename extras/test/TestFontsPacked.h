@@ -0,0 +1,51 @@
+/*
+ * TestFontsPacked glyphs generated by U8x8TilesR3_glyphc from extras/glyphc/letters.pbm extras/glyphc/digits.pbm extras/glyphc/letters4.pbm
+ * Include after U8x8TilesR3.h.
+ */
+
+#ifndef TESTFONTSPACKED_GLYPHS_H_
+#define TESTFONTSPACKED_GLYPHS_H_
+
+namespace TestFontsPacked {
+  constexpr uint8_t tiles[570] U8X8TILESR3_PROGMEM = {
+    146, 56, 68, 124, 68, 0, 144, 120, 68, 120, 68, 124, 0, 136, 56, 68, 64, 68, 56, 0, 156, 120, 68, 120, 0, 144, 124, 64, 120, 64, 124, 0, 146, 124, 64, 120, 64, 0, 128, 56, 68, 64, 92, 68, 56, 0, 178, 68, 124, 68, 0,
+    156, 124, 16, 124, 0, 184, 4, 68, 56, 0, 136, 68, 72, 112, 72, 68, 0, 188, 64, 124, 0, 134, 68, 108, 84, 68, 0, 130, 68, 100, 84, 76, 68, 0, 156, 56, 68, 56, 0, 146, 120, 68, 120, 64, 0,
+    144, 56, 68, 84, 76, 60, 0, 144, 120, 68, 120, 72, 68, 0, 128, 56, 68, 32, 24, 68, 56, 0, 158, 124, 16, 0, 188, 68, 56, 0, 184, 68, 40, 16, 0, 172, 68, 84, 40, 0, 160, 68, 40, 16, 40, 68, 0,
+    166, 68, 40, 16, 0, 128, 124, 4, 8, 16, 32, 124, 0, 140, 48, 80, 16, 124, 0, 128, 56, 68, 8, 16, 32, 124, 0, 128, 56, 68, 4, 24, 68, 56, 0, 128, 8, 24, 40, 72, 124, 8, 0, 128, 124, 64, 56, 4, 68, 56, 0, 132, 56, 64, 120, 68, 56, 0,
+    128, 124, 4, 8, 16, 32, 64, 0, 132, 56, 68, 56, 68, 56, 0, 144, 56, 68, 60, 4, 56, 0, 132, 3, 7, 28, 56, 112, 127, 132, 192, 224, 56, 28, 14, 254, 63, 127, 96, 63, 254, 6, 174, 127, 96, 127,
+    132, 248, 252, 12, 6, 12, 252, 61, 127, 96, 127, 24, 248, 12, 6, 12, 252, 248, 131, 15, 31, 56, 112, 96, 133, 248, 252, 14, 6, 0, 112, 96, 112, 56, 31, 15, 232, 6, 14, 252, 248, 175, 127, 96,
+    135, 248, 252, 12, 6, 125, 96, 127, 120, 6, 12, 252, 248, 174, 254, 0, 248, 61, 248, 0, 254, 63, 248, 0, 135, 31, 63, 112, 96, 174, 254, 0, 124,
+    120, 96, 112, 63, 31, 56, 126, 6, 14, 254, 252, 190, 96, 127, 190, 6, 254, 175, 31, 1, 175, 248, 128, 125, 1, 31, 125, 128, 248,
+    255, 175, 62, 6, 232, 96, 112, 63, 31, 176, 96, 97, 103, 126, 120, 129, 6, 30, 120, 224, 128, 0, 3, 120, 124, 102, 103, 97, 96, 224, 128, 224, 120, 30, 6, 191, 96,
+    253, 254, 131, 96, 120, 126, 103, 97, 131, 6, 30, 126, 230, 134, 127, 96, 127, 6, 176, 96, 120, 126, 103, 97, 188, 6, 134, 230, 31, 126, 30, 6,
+    135, 252, 254, 14, 6, 120, 6, 14, 254, 252, 132, 252, 254, 14, 6, 14, 252, 0, 6, 198, 230, 118, 62, 30, 254, 252, 7, 127, 124, 111, 99, 96, 32, 248, 0, 192, 240, 60, 14, 6, 134, 31, 63, 112, 96, 63, 130, 248, 252, 14, 6, 0, 252,
+    48, 31, 0, 96, 112, 63, 31, 24, 254, 14, 6, 14, 252, 248, 175, 127, 1, 175, 254, 128, 127, 1, 127, 128, 191, 6, 96, 96, 112, 56, 30, 7, 1,
+    96, 6, 14, 28, 120, 224, 128, 80, 96, 97, 103, 126, 120, 96, 80, 6, 134, 230, 126, 30, 6, 184, 96, 120, 30, 7, 184, 6, 30, 120, 224, 7, 1, 7, 30, 120, 96, 15, 224, 248, 30, 6, 174, 127, 0, 1,
+    168, 254, 6, 30, 120, 224, 13, 7, 30, 120, 96, 127, 61, 128, 0, 254
+  };
+  constexpr uint16_t blocks[14] U8X8TILESR3_PROGMEM = { 0, 51, 96, 143, 201, 247, 291, 324, 353, 390, 422, 475, 508, 554 };
+  // extras/glyphc/letters.pbm, codes 65 - 90
+  constexpr uint8_t lettersGlyphs[26][1] U8X8TILESR3_PROGMEM = {
+    { 0 }, { 1 }, { 2 }, { 3 }, { 4 }, { 5 }, { 6 }, { 7 },
+    { 8 }, { 9 }, { 10 }, { 11 }, { 12 }, { 13 }, { 14 }, { 15 },
+    { 16 }, { 17 }, { 18 }, { 19 }, { 20 }, { 21 }, { 22 }, { 23 },
+    { 24 }, { 25 }
+  };
+  constexpr U8x8TilesR3Font letters = { tiles, blocks, lettersGlyphs[0], 65, 26, 1, 1, nullptr };
+  // extras/glyphc/digits.pbm, codes 48 - 57
+  constexpr uint8_t digitsGlyphs[10][1] U8X8TILESR3_PROGMEM = {
+    { 14 }, { 26 }, { 27 }, { 28 }, { 29 }, { 30 }, { 31 }, { 32 },
+    { 33 }, { 34 }
+  };
+  constexpr U8x8TilesR3Font digits = { tiles, blocks, digitsGlyphs[0], 48, 10, 1, 1, nullptr };
+  // extras/glyphc/letters4.pbm, codes 65 - 90
+  constexpr uint8_t letters4Glyphs[26][4] U8X8TILESR3_PROGMEM = {
+    { 35, 36, 37, 38 }, { 39, 40, 41, 42 }, { 43, 44, 45, 46 }, { 47, 48, 49, 50 }, { 39, 51, 41, 52 }, { 39, 51, 37, 53 }, { 54, 55, 56, 57 }, { 58, 59, 37, 38 },
+    { 60, 61, 62, 63 }, { 64, 65, 66, 50 }, { 67, 68, 69, 70 }, { 71, 64, 49, 72 }, { 73, 74, 75, 76 }, { 77, 78, 75, 79 }, { 54, 80, 56, 81 }, { 39, 82, 37, 53 },
+    { 54, 80, 56, 83 }, { 39, 40, 84, 85 }, { 86, 87, 88, 89 }, { 90, 91, 92, 93 }, { 71, 94, 56, 81 }, { 71, 94, 95, 96 }, { 71, 94, 97, 98 }, { 99, 100, 101, 102 },
+    { 99, 100, 92, 93 }, { 103, 104, 105, 106 }
+  };
+  constexpr U8x8TilesR3Font letters4 = { tiles, blocks, letters4Glyphs[0], 65, 26, 2, 2, nullptr };
+}
+
+#endif /* TESTFONTSPACKED_GLYPHS_H_ */
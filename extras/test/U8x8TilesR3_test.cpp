@@ -0,0 +1,531 @@
+/*
+ * U8x8TilesR3_test.cpp
+ *
+ * Host checks of U8x8TilesR3 drawing against the mock display. Each check draws the same
+ * thing two ways, or against a table of expected results, and compares what ends up on the
+ * panel, so the library's optimisations can be verified without an SH1107 board.
+ * Prints each failing check and exits with the number of failures.
+ *
+ * Build and run from the library folder, with any library options as -D flags:
+ *   g++ -std=gnu++11 -O2 -Iextras/host -I. extras/test/U8x8TilesR3_test.cpp -o test && ./test
+ *   g++ -std=gnu++11 -O2 -Iextras/host -I. -DU8X8TILESR3_SHADOW=U8X8TILESR3_SHADOW_HASH \
+ *       -DU8X8TILESR3_BATCH_SIZE=16 extras/test/U8x8TilesR3_test.cpp -o test && ./test
+ *
+ * TestFonts.h and TestFontsPacked.h are generated from the sample sheets in extras/glyphc:
+ *   ./glyphc -n TestFonts -o extras/test/TestFonts.h -f 65 extras/glyphc/letters.pbm \
+ *       -f 48 extras/glyphc/digits.pbm -s 2x2 -f 65 extras/glyphc/letters4.pbm
+ * and the same with -n TestFontsPacked -o extras/test/TestFontsPacked.h -r.
+ */
+
+#include <stdio.h>
+#include "MockU8x8.h"
+
+MockU8x8 u8x8;
+MockU8x8 ref;
+
+#include "U8x8TilesR3.h"
+#include "TestFonts.h"
+#include "TestFontsPacked.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *name, long detail = 0) {
+  if (ok) return;
+  printf("FAIL %s (%ld)\n", name, detail);
+  failures++;
+}
+
+/* Pixel px, py of a panel of the given pages mounted with rotation, as the viewer sees it with (0, 0) at the top left.
+* ROTATE_180 and ROTATE_270 viewers see the controller's flip mode turned back by the mounting.
+*/
+static bool mountedPixel(const MockU8x8 &m, uint8_t rotation, uint8_t pages, int px, int py) {
+  bool landscape = !(rotation & 1);
+  uint8_t col = (landscape ? px : py) / 8 - 12;
+  uint8_t page = landscape ? py / 8 : pages - 1 - px / 8;
+  int row = landscape ? px % 8 : py % 8;
+  int bit = landscape ? py % 8 : 7 - px % 8;
+  if (rotation >= U8x8TilesR3::ROTATE_180) {
+    col = 15 - col;
+    page = pages - 1 - page;
+    row = 7 - row;
+    bit = 7 - bit;
+  }
+  return (m.tileAt(col, page)[row] >> bit) & 1;
+}
+
+/* Pixel px, py of the 128 x 128 panel as the viewer sees it, with (0, 0) at the top left */
+static bool pixel(const MockU8x8 &m, bool landscape, int px, int py) {
+  return mountedPixel(m, landscape ? U8x8TilesR3::ROTATE_0 : U8x8TilesR3::ROTATE_90, 16, px, py);
+}
+
+/* Number of pixels that differ between the two mock panels as seen by the viewer */
+static int differences(bool landscape = false, bool refLandscape = false) {
+  int n = 0;
+  for (int py = 0; py < 128; py++) {
+    for (int px = 0; px < 128; px++) n += pixel(u8x8, landscape, px, py) != pixel(ref, refLandscape, px, py);
+  }
+  return n;
+}
+
+static void clearBoth(U8x8TilesR3 &a, U8x8TilesR3 &b) {
+  u8x8.clear();
+  ref.clear();
+  a.invalidate();
+  b.invalidate();
+}
+
+/* The dial thresholds keep the original val * 0.0118 mapping */
+static void testDialStates() {
+  int wrong = 0;
+  for (int val = 0; val <= 1024; val++) wrong += U8x8TilesR3Dial<9>::stateOf(val) != (int)(val * 0.0118);
+  check(wrong == 0, "dial states", wrong);
+}
+
+/* Number rendering against expected fields, ' ' blank, '-' negative, '#' too wide */
+static void testNumbers() {
+  static const struct { long value; uint8_t width; uint8_t format; const char *shown; } cases[] = {
+    { 0, 3, 0, "  0" }, { 42, 3, 0, " 42" }, { -5, 3, 0, " -5" }, { 999, 3, 0, "999" }, { 1000, 3, 0, "###" },
+    { 1234, 5, 1, "123.4" }, { 5, 3, 2, ".05" }, { -5, 4, 1, "-0.5" }, { 12345, 3, U8x8TilesR3Number::SCALE, "12K" },
+    { 1500000, 4, U8x8TilesR3Number::SCALE, "1.5M" }, { 0, 1, 0, "0" },
+  };
+  static const char symbols[] = "0123456789 .-KM#";
+  for (uint8_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    uint8_t codes[16];
+    char shown[17];
+    U8x8TilesR3Number::render(codes, cases[c].width, cases[c].value, cases[c].format);
+    for (uint8_t i = 0; i < cases[c].width; i++) shown[i] = symbols[codes[i]];
+    shown[cases[c].width] = 0;
+    check(strcmp(shown, cases[c].shown) == 0, "number rendering", cases[c].value);
+  }
+  uint8_t guard[2] = { 0xAA, 0xAA };
+  U8x8TilesR3Number::render(guard + 1, 0, 0, 0);
+  check(guard[0] == 0xAA && guard[1] == 0xAA, "zero-width number");
+  // long is 32 bits on AVR, where scaling to M with 7 decimal places divides by up to 10^13
+  uint8_t codes[3];
+  U8x8TilesR3Number::renderAs<uint32_t>(codes, 3, 2000000000L, 4 | U8x8TilesR3Number::SCALE);
+  check(codes[0] == U8x8TilesR3Number::DOT && codes[1] == 2 && codes[2] == U8x8TilesR3Number::MEGA, "32-bit scaled number");
+  uint32_t seed = 17;
+  int wrong = 0;
+  for (int i = 0; i < 20000; i++) {
+    seed = seed * 1103515245 + 12345;
+    int32_t value = (int32_t)(seed ^ (seed << 13)) >> (seed % 24);
+    uint8_t width = 1 + (seed >> 24) % 8, format = (seed >> 8) & 15;
+    uint8_t narrow[8], wide[8];
+    U8x8TilesR3Number::renderAs<uint32_t>(narrow, width, value, format);
+    U8x8TilesR3Number::renderAs<uint64_t>(wide, width, value, format);
+    wrong += memcmp(narrow, wide, width) != 0;
+  }
+  check(wrong == 0, "32-bit and 64-bit number rendering", wrong);
+}
+
+static void drawRotationScene(U8x8TilesR3 &display, bool small) {
+  if (small) {
+    display.drawWord(0, 0, "ROT", 3, U8x8TilesR3::OVERLAY_UNDERLINE);
+    display.drawDial9(3, 1, 700);
+    display.drawNumberField(0, 4, 1234L, 5, 1);
+    display.drawGlyph<2, 2>(5, 5, U8x8TilesR3Glyphs::letters4[6], true);
+    display.drawHeightMark(0, 6, 3);
+    return;
+  }
+  display.drawWord(0, 0, "ROTATE 90", 9, U8x8TilesR3::OVERLAY_UNDERLINE);
+  display.drawWord4(0, 2, "TILE", 4);
+  display.drawDial9(9, 2, 700);
+  display.drawVUBar5(13, 5, 27);
+  display.drawNumberField(0, 6, 1234L, 5, 1);
+  display.drawCircle4_2(0, 8);
+  display.drawGlyph<2, 2>(3, 8, U8x8TilesR3Glyphs::letters4[6], true);
+  display.drawHeightMark(6, 9, 3);
+}
+
+/* Pixels of the top left size x size that differ between u8x8 and ref as their viewers see them */
+static int mountedDifferences(uint8_t rotation, uint8_t refRotation, uint8_t pages, int size) {
+  int n = 0;
+  for (int py = 0; py < size; py++) {
+    for (int px = 0; px < size; px++) n += mountedPixel(u8x8, rotation, pages, px, py) != mountedPixel(ref, refRotation, pages, px, py);
+  }
+  return n;
+}
+
+/* The same drawing looks the same in every mounting, on 128 x 128 and 128 x 64 panels */
+static void testRotation() {
+  static const char *names[2][4] = {
+    { "rotate 0 and 90", "rotate 90 and 90", "rotate 180 and 90", "rotate 270 and 90" },
+    { "8 pages rotate 0 and 90", "8 pages rotate 90 and 90", "8 pages rotate 180 and 90", "8 pages rotate 270 and 90" },
+  };
+  for (uint8_t small = 0; small < 2; small++) {
+    uint8_t pages = small ? 8 : 16;
+    u8x8.setPages(pages);
+    ref.setPages(pages);
+    for (uint8_t rotation = U8x8TilesR3::ROTATE_0; rotation <= U8x8TilesR3::ROTATE_270; rotation++) {
+      U8x8TilesR3 mounted(u8x8);
+      U8x8TilesR3 portrait(ref);
+      mounted.setRotation(rotation, pages);
+      portrait.setRotation(U8x8TilesR3::ROTATE_90, pages);
+      clearBoth(mounted, portrait);
+      drawRotationScene(mounted, small);
+      drawRotationScene(portrait, small);
+      int n = mountedDifferences(rotation, U8x8TilesR3::ROTATE_90, pages, small ? 64 : 128);
+      check(n == 0, names[small][rotation], n);
+      if (!small) continue;
+      // nothing lands past the last page of a 128 x 64 panel
+      int outside = 0;
+      for (uint8_t page = 8; page < 16; page++) {
+        for (int col = 0; col < 256; col++) {
+          for (uint8_t i = 0; i < 8; i++) outside += u8x8.tileAt(col, page)[i] != 0;
+        }
+      }
+      check(outside == 0, "8 pages stay on the panel", outside);
+    }
+  }
+  u8x8.setPages(16);
+  ref.setPages(16);
+  u8x8.setFlipMode(0);
+}
+
+/* Generated fonts draw the same pixels as the built-in glyphs, plain and compressed */
+static void testFonts() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3 builtIn(ref);
+  const U8x8TilesR3Font *letters[2] = { &TestFonts::letters, &TestFontsPacked::letters };
+  const U8x8TilesR3Font *digits[2] = { &TestFonts::digits, &TestFontsPacked::digits };
+  const U8x8TilesR3Font *letters4[2] = { &TestFonts::letters4, &TestFontsPacked::letters4 };
+  for (uint8_t f = 0; f < 2; f++) {
+    clearBoth(display, builtIn);
+    display.drawString(0, 0, *letters[f], "ABCDEFGHIJKLM");
+    display.drawString(0, 1, *letters[f], "NOPQRSTUVWXYZ");
+    display.drawString(0, 2, *digits[f], "0123456789");
+    display.drawString(0, 4, *letters4[f], "ABCDEFGH");
+    display.drawString(0, 6, *letters4[f], "STUVWXYZ");
+    builtIn.drawWord(0, 0, "ABCDEFGHIJKLM");
+    builtIn.drawWord(0, 1, "NOPQRSTUVWXYZ");
+    builtIn.drawWord(0, 2, "0123456789");
+    builtIn.drawWord4(0, 4, "ABCDEFGH");
+    builtIn.drawWord4(0, 6, "STUVWXYZ");
+    check(differences() == 0, f ? "compressed font" : "font", differences());
+  }
+  // a pool of more than 256 tiles, as glyphc writes it with 16-bit glyph indices;
+  // built in RAM, which the library reads as flash on the host only
+  static uint8_t pool[300][8];
+  static const uint16_t wideGlyphs[4][1] U8X8TILESR3_PROGMEM = { { 299 }, { 256 }, { 255 }, { 3 } };
+  for (int i = 0; i < 300; i++) {
+    for (int r = 0; r < 8; r++) pool[i][r] = (uint8_t)(i * 7 + r * (i >> 8 ? 41 : 13));
+  }
+  const U8x8TilesR3Font wide = { pool[0], nullptr, nullptr, 65, 4, 1, 1, wideGlyphs[0] };
+  clearBoth(display, builtIn);
+  display.drawString(0, 0, wide, "ABCD");
+  for (int g = 0; g < 4; g++) builtIn.drawIcon(g, 0, &pool[wideGlyphs[g][0]], 1, 1);
+  check(differences() == 0, "16-bit glyph indices", differences());
+  // a full 8-bit font, 256 glyphs from code 0
+  static uint8_t glyphs[256];
+  for (int g = 0; g < 256; g++) glyphs[g] = 255 - g;
+  const U8x8TilesR3Font full = { pool[0], nullptr, glyphs, 0, 256, 1, 1, nullptr };
+  clearBoth(display, builtIn);
+  display.drawChar(0, 0, full, (char)255);
+  display.drawChar(1, 0, full, 'A');
+  builtIn.drawIcon(0, 0, &pool[0], 1, 1);
+  builtIn.drawIcon(1, 0, &pool[255 - 'A'], 1, 1);
+  check(differences() == 0, "256-glyph font", differences());
+}
+
+/* The invert overlay flips every pixel of a letter */
+static void testOverlays() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3 plain(ref);
+  clearBoth(display, plain);
+  display.drawLetter(0, 0, 4, U8x8TilesR3::OVERLAY_INVERT);
+  plain.drawLetter(0, 0, 4);
+  int inverted = 0;
+  for (int py = 0; py < 8; py++) {
+    for (int px = 0; px < 8; px++) inverted += pixel(u8x8, false, px, py) != pixel(ref, false, px, py);
+  }
+  check(inverted == 64, "inverted letter", inverted);
+  // overlays passed without a length are not taken as one
+  clearBoth(display, plain);
+  display.drawWord(0, 1, "HELLO", U8x8TilesR3::OVERLAY_INVERT | U8x8TilesR3::OVERLAY_UNDERLINE);
+  plain.drawWord(0, 1, "HELLO", 5, U8x8TilesR3::OVERLAY_INVERT | U8x8TilesR3::OVERLAY_UNDERLINE);
+  check(differences() == 0, "word overlays without a length", differences());
+}
+
+#if U8X8TILESR3_BATCH_SIZE > 0
+/* Drawing queued in asynchronous mode and sent by service(), with any budget,
+* ends with the same panel as drawing directly */
+static void testAsync() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3 direct(ref);
+  clearBoth(display, direct);
+  display.setAsync(true);
+  U8x8TilesR3VUMeter meters[4] = { {0, 8}, {1, 8}, {2, 8}, {3, 8} };
+  U8x8TilesR3VUMeter refMeters[4] = { {0, 8}, {1, 8}, {2, 8}, {3, 8} };
+  int levels[4] = { 0 };
+  uint32_t seed = 13;
+  for (uint16_t frame = 0; frame < 300; frame++) {
+    for (uint8_t i = 0; i < 4; i++) {
+      seed = seed * 1103515245 + 12345;
+      levels[i] = (seed >> 16) % 41;
+    }
+    display.drawVUMeters(meters, levels, 4);
+    direct.drawVUMeters(refMeters, levels, 4);
+    display.drawNumberField(6, 1, (long)frame, 4);
+    direct.drawNumberField(6, 1, (long)frame, 4);
+    display.drawWord(6, 3, frame % 2 ? "ODD" : "EVEN", 4);
+    direct.drawWord(6, 3, frame % 2 ? "ODD" : "EVEN", 4);
+    display.service(frame % 3 ? 300 : 0);
+  }
+  while (display.service(1000)) { }
+  display.setAsync(false);
+  check(differences() == 0, "asynchronous and direct drawing", differences());
+}
+
+/* Two panels sent by the scheduler end with the same panels as drawing each directly */
+static void testScheduler() {
+  MockU8x8 second;
+  MockU8x8 secondRef;
+  U8x8TilesR3 a(u8x8), b(second), aRef(ref), bRef(secondRef);
+  U8x8TilesR3Scheduler<U8X8> scheduler;
+  scheduler.add(a);
+  scheduler.add(b);
+  clearBoth(a, aRef);
+  second.clear();
+  secondRef.clear();
+  b.invalidate();
+  bRef.invalidate();
+  U8x8TilesR3VUMeter meters[4] = { {0, 8}, {1, 8}, {2, 8}, {3, 8} };
+  U8x8TilesR3VUMeter refMeters[4] = { {0, 8}, {1, 8}, {2, 8}, {3, 8} };
+  int levels[4] = { 0 };
+  uint32_t seed = 5;
+  for (uint16_t frame = 0; frame < 300; frame++) {
+    for (uint8_t i = 0; i < 4; i++) {
+      seed = seed * 1103515245 + 12345;
+      levels[i] = (seed >> 16) % 41;
+    }
+    a.drawVUMeters(meters, levels, 4);
+    aRef.drawVUMeters(refMeters, levels, 4);
+    a.drawNumberField(6, 1, (long)frame, 4);
+    aRef.drawNumberField(6, 1, (long)frame, 4);
+    b.drawDial9(4, 4, frame * 3);
+    bRef.drawDial9(4, 4, frame * 3);
+    b.drawWord(0, 0, frame % 2 ? "ODD" : "EVEN", 4);
+    bRef.drawWord(0, 0, frame % 2 ? "ODD" : "EVEN", 4);
+    scheduler.service(frame % 3 ? 300 : 0);
+  }
+  while (scheduler.service(1000)) { }
+  bool same = true;
+  for (int p = 0; p < 16; p++) {
+    for (int c = 0; c < 256; c++) {
+      same = same && memcmp(u8x8.tileAt(c, p), ref.tileAt(c, p), 8) == 0;
+      same = same && memcmp(second.tileAt(c, p), secondRef.tileAt(c, p), 8) == 0;
+    }
+  }
+  check(same, "scheduler and direct drawing");
+  a.setAsync(false);
+  b.setAsync(false);
+}
+#endif
+
+/* A screen of overlapping widgets, changed at random, always shows what clearing the display
+* and drawing every visible widget from the bottom up shows */
+static void testScreen() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3 redraw(ref);
+  clearBoth(display, redraw);
+  U8x8TilesR3Screen<U8X8> screen(display);
+  U8x8TilesR3Screen<U8X8> reference(redraw);
+  static const char *words[] = { "MENU", "FILTER", "LFO", "" };
+  static const uint8_t (*icons[2])[8] = { U8x8TilesR3Glyphs::circle4, U8x8TilesR3Glyphs::circle4_3 };
+  U8x8TilesR3LabelWidget label(0, 0, 8), labelRef(0, 0, 8);
+  U8x8TilesR3LabelWidget item(4, 0, 6), itemRef(4, 0, 6);
+  U8x8TilesR3DialWidget dial(2, 2), dialRef(2, 2);
+  U8x8TilesR3NumberWidget value(1, 4, 5, 1), valueRef(1, 4, 5, 1);
+  U8x8TilesR3VUBarWidget meter(3, 1, 5), meterRef(3, 1, 5);
+  U8x8TilesR3IconWidget icon(4, 3, 2, 2, icons[0]), iconRef(4, 3, 2, 2, icons[0]);
+  U8x8TilesR3StripChart<4, 2> chart(6, 4), chartRef(6, 4);
+  U8x8TilesR3Widget *widgets[7] = { &label, &item, &dial, &value, &meter, &icon, &chart };
+  U8x8TilesR3Widget *refs[7] = { &labelRef, &itemRef, &dialRef, &valueRef, &meterRef, &iconRef, &chartRef };
+  for (uint8_t i = 0; i < 7; i++) {
+    screen.add(*widgets[i]);
+    reference.add(*refs[i]);
+  }
+  uint32_t seed = 11;
+  int wrong = 0;
+  for (uint16_t frame = 0; frame < 2000; frame++) {
+    seed = seed * 1103515245 + 12345;
+    uint8_t w = (seed >> 16) % 7;
+    uint16_t r = seed >> 20;
+    if (r % 8 == 0) {
+      widgets[w]->setVisible(!(r & 16));
+      refs[w]->setVisible(!(r & 16));
+    }
+    switch (w) {
+      case 0: label.set(words[r % 4]); labelRef.set(words[r % 4]); break;
+      case 1: item.setOverlays(r & 32 ? U8x8TilesR3::OVERLAY_INVERT : 0); itemRef.setOverlays(r & 32 ? U8x8TilesR3::OVERLAY_INVERT : 0); break;
+      case 2: dial.set(r % 1025); dialRef.set(r % 1025); break;
+      case 3: value.set((long)(r % 3000) - 1000); valueRef.set((long)(r % 3000) - 1000); break;
+      case 4: meter.set(r % 41); meterRef.set(r % 41); break;
+      case 5: icon.set(icons[r & 1]); iconRef.set(icons[r & 1]); break;
+      case 6: chart.add(r % 16, r % 16 + r % 3); chartRef.add(r % 16, r % 16 + r % 3); break;
+    }
+    screen.render();
+    ref.clear();
+    redraw.invalidate();
+    reference.invalidate();
+    reference.render();
+    wrong += differences() != 0;
+  }
+  check(wrong == 0, "screen and full redraw", wrong);
+}
+
+/* Strip charts draw every column span, in both scroll modes */
+static void testChart() {
+  for (uint8_t mode = 0; mode < 2; mode++) {
+    U8x8TilesR3 display(u8x8);
+    u8x8.clear();
+    U8x8TilesR3StripChart<5, 3> chart(2, 4);
+    chart.setScroll(mode ? U8x8TilesR3ChartWidget::SCROLL_TILE : U8x8TilesR3ChartWidget::SCROLL_PIXEL);
+    uint8_t low[300], high[300];
+    uint32_t seed = 7;
+    int wrong = 0;
+    for (int n = 1; n <= 300; n++) {
+      seed = seed * 1103515245 + 12345;
+      int a = (int)((seed >> 16) % 30) - 3;
+      int b = a + (seed >> 8) % 5;
+      if (n % 40 < 10) a = b = 5;
+      chart.add(a, b);
+      low[n - 1] = a < 0 ? 0 : (a > 23 ? 23 : a);
+      high[n - 1] = b < 0 ? 0 : (b > 23 ? 23 : b);
+      display.drawChart(chart);
+      int end = mode ? 32 + (n % 8 ? n % 8 : 8) : 40;
+      for (int c = 0; c < 40; c++) {
+        for (int l = 0; l < 24; l++) {
+          int j = n - (end - c);
+          bool want = c < end && j >= 0 && l >= low[j] && l <= high[j];
+          wrong += pixel(u8x8, false, 16 + c, 32 + 23 - l) != want;
+        }
+      }
+    }
+    check(wrong == 0, mode ? "chart tile scroll" : "chart pixel scroll", wrong);
+  }
+}
+
+/* Every step of a marquee shows the text shifted by its offset, in small and large letters */
+static void testMarquee() {
+  const char *text = "FILTER CUTOFF 42";
+  for (uint8_t large = 0; large < 2; large++) {
+    U8x8TilesR3 display(u8x8);
+    U8x8TilesR3 strip(ref);
+    clearBoth(display, strip);
+    U8x8TilesR3Marquee marquee(0, 8, 10, large);
+    marquee.setText(text);
+    marquee.setGap(3);
+    int width = large ? 2 : 1;
+    int period = (strlen(text) * width + 3) * 8;
+    // the first 16 tiles of the text drawn at full size from the top of the reference panel;
+    // the period is wider than the panel, so the gap and the second pass are never compared
+    if (large) {
+      strip.drawWord4(0, 0, text, 8);
+    } else {
+      strip.drawWord(0, 0, text, 16);
+    }
+    int wrong = 0;
+    for (int offset = 0; offset < period; offset += 3) {
+      marquee.offset = offset;
+      display.drawMarquee(marquee);
+      for (int row = 0; row < 8 * width; row++) {
+        for (int c = 0; c < 80 && offset + c < 128; c++) {
+          wrong += pixel(u8x8, false, c, 64 + row) != pixel(ref, false, offset + c, row);
+        }
+      }
+    }
+    check(wrong == 0, large ? "large marquee" : "marquee", wrong);
+  }
+}
+
+/* Region fills match drawing each tile, queued tiles under a fill are dropped */
+static void testRegions() {
+  static const uint8_t pattern[8] U8X8TILESR3_PROGMEM = { 1, 2, 4, 8, 16, 32, 64, 128 };
+  for (uint8_t rotation = 0; rotation < 2; rotation++) {
+    U8x8TilesR3 display(u8x8);
+    U8x8TilesR3 tiles(ref);
+    display.setRotation(rotation);
+    tiles.setRotation(rotation);
+    clearBoth(display, tiles);
+    uint32_t seed = 3;
+    int wrong = 0;
+    for (int i = 0; i < 200; i++) {
+      seed = seed * 1103515245 + 12345;
+      int x = (seed >> 8) % 10, y = (seed >> 12) % 10, w = 1 + (seed >> 16) % 6, h = 1 + (seed >> 20) % 6;
+      switch ((seed >> 24) % 3) {
+        case 0:
+          display.drawWord(x, y, "HELLO", 5);
+          tiles.drawWord(x, y, "HELLO", 5);
+          break;
+        case 1:
+          display.beginBatch();
+          display.drawWord(x, y, "AB12", 4);
+          display.fillRegion(x + 1, y, w, h, pattern);
+          display.flush();
+          tiles.drawWord(x, y, "AB12", 4);
+          for (int t = 0; t < w * h; t++) tiles.drawIcon(x + 1 + t % w, y + t / w, &pattern, 1, 1);
+          break;
+        case 2:
+          display.clearRegion(x, y, w, h);
+          for (int t = 0; t < w * h; t++) tiles.drawBlank(x + t % w, y + t / w);
+          break;
+      }
+      wrong += differences(!rotation, !rotation) != 0;
+    }
+    check(wrong == 0, rotation ? "regions portrait" : "regions landscape", wrong);
+  }
+}
+
+/* Animators stepping through circle4Fill in any order show the matching circle4 frame */
+static void testAnimation() {
+  U8x8TilesR3 display(u8x8);
+  U8x8TilesR3 frames(ref);
+  clearBoth(display, frames);
+  U8x8TilesR3Animator leds[3] = { {14, 0}, {14, 2}, {12, 0} };
+  uint32_t seed = 9;
+  int wrong = 0;
+  for (int i = 0; i < 300; i++) {
+    seed = seed * 1103515245 + 12345;
+    U8x8TilesR3Animator &led = leds[(seed >> 10) % 3];
+    if ((seed >> 20) % 2) display.stepAnimation(U8x8TilesR3Glyphs::circle4Fill, led, (seed >> 16) % 6);
+    else display.drawAnimation(U8x8TilesR3Glyphs::circle4Fill, led, (seed >> 16) % 6);
+    frames.drawGlyph<2, 2>(led.x, led.y, U8x8TilesR3Glyphs::circle4Frames[led.frame]);
+    wrong += differences() != 0;
+  }
+  check(wrong == 0, "animation frames", wrong);
+  // more tiles than an animator tracks draws nothing
+  static const uint8_t key[20] U8X8TILESR3_PROGMEM = { 0 };
+  static const uint8_t deltas[1] U8X8TILESR3_PROGMEM = { 0 };
+  const U8x8TilesR3Animation large = { U8x8TilesR3Glyphs::circle4Frames[0][0], key, deltas, 1, 5, 4 };
+  U8x8TilesR3Animator big(0, 0);
+  u8x8.resetStats();
+  display.drawAnimation(large, big, 0);
+  check(u8x8.tiles == 0 && !big.drawn, "animation of more than 16 tiles", u8x8.tiles);
+  // a zero interval steps a frame per microsecond instead of dividing by zero
+  U8x8TilesR3Animator fast(14, 0);
+  fast.setInterval(0);
+  display.updateAnimation(U8x8TilesR3Glyphs::circle4Fill, fast);
+  mockDelayMicros(5);
+  check(display.updateAnimation(U8x8TilesR3Glyphs::circle4Fill, fast) && fast.interval == 1, "zero animation interval");
+}
+
+int main() {
+  printf("U8x8TilesR3 test: shadow %d, batch %d, stats %d\n", U8X8TILESR3_SHADOW, U8X8TILESR3_BATCH_SIZE, U8X8TILESR3_STATS);
+  testDialStates();
+  testNumbers();
+  testRotation();
+  testFonts();
+  testOverlays();
+#if U8X8TILESR3_BATCH_SIZE > 0
+  testAsync();
+  testScheduler();
+#endif
+  testScreen();
+  testChart();
+  testMarquee();
+  testRegions();
+  testAnimation();
+  printf("%d failed\n", failures);
+  return failures;
+}